@@ -1,28 +1,74 @@
 #include <iostream>
 #include "C:\Users\User\OneDrive - Asia Pacific University\DSA\DataStruck-1\include\AmalHPP.hpp"
+#include <cstdio>
 #include <fstream>
 #include <sstream>
+#include <vector>
+#include "../include/csvReader.hpp"
+#include "../include/dateKey.hpp"
+#include "../include/snapshot.hpp"
 using namespace std;
 
+// Fills t from one line using the column layout read from the header.
+// Returns false for rows with missing fields or an unreadable price.
+bool parseTransactionLine(const TransactionLayout& layout, const FieldView& line, Transaction& t){
+    FieldView fields[TX_FIELD_COUNT];
+    if(!layout.split(line, fields)) return false;
+    if(!parseDouble(fields[TX_PRICE], t.price)) return false;
+
+    t.customerID.assign(fields[TX_CUSTOMER].ptr, fields[TX_CUSTOMER].len);
+    t.product.assign(fields[TX_PRODUCT].ptr, fields[TX_PRODUCT].len);
+    t.date.assign(fields[TX_DATE].ptr, fields[TX_DATE].len);
+    t.dateKey = parseDateKey(fields[TX_DATE].ptr, fields[TX_DATE].len);
+    t.category.assign(fields[TX_CATEGORY].ptr, fields[TX_CATEGORY].len);
+    t.paymentMethod.assign(fields[TX_PAYMENT].ptr, fields[TX_PAYMENT].len);
+    return true;
+}
+
 void loadTransactionsFromCSV(const string& filename, TransactionLinkedListStore& store){
     ifstream file(filename);
     string line;
     getline(file, line);
 
+    TransactionLayout layout;
+    layout.fromHeader(FieldView(line.data(), line.size()));
+
     while(getline(file, line)){
-        stringstream ss(line);
         Transaction t;
-        string token;
-
-        getline(ss, t.customerID, ',');
-        getline(ss, t.product, ',');
-        getline(ss, token, ',');
-        t.price = stod(token);
-        getline(ss, t.date, ',');
-        getline(ss, t.category, ',');
-        getline(ss, t.paymentMethod);
+        if(parseTransactionLine(layout, FieldView(line.data(), line.size()), t)){
+            store.insert(t);
+        }
+    }
+}
 
-        store.insert(t);
+// Parallel ingest: each worker parses a newline-aligned range of the mapped
+// file into its own chain of nodes, then the chains are spliced in file
+// order so the store ends up identical to loadTransactionsFromCSV.
+void loadTransactionsFromCSVParallel(const string& filename, TransactionLinkedListStore& store, unsigned workers = 0){
+    MappedFile file;
+    if(!file.open(filename)) return;
+
+    LineCursor cursor(file.begin(), file.end());
+    FieldView line;
+    TransactionLayout layout;
+    if(cursor.next(line)) layout.fromHeader(line);
+
+    vector<const char*> bounds;
+    size_t chunks = splitLineAlignedChunks(cursor.position(), file.end(),
+                                           workers == 0 ? defaultWorkerCount() : workers, bounds);
+    vector<TransactionLinkedListStore> parts(chunks);
+
+    parallelForChunks(bounds, [&](size_t chunk, const char* begin, const char* end){
+        LineCursor local(begin, end);
+        FieldView row;
+        while(local.next(row)){
+            Transaction t;
+            if(parseTransactionLine(layout, row, t)) parts[chunk].insert(t);
+        }
+    });
+
+    for(size_t chunk = 0; chunk < chunks; chunk++){
+        store.splice(parts[chunk]);
     }
 }
 
@@ -46,12 +92,61 @@ void loadReviewsFromCSV(const string& filename, ReviewLinkedListStore& store) {
     }
 }
 
+// Fills the store from a binary snapshot written by the cleaner. Rows are
+// read from the mapped columns, so nothing is parsed. Returns false if the
+// file is missing or not a valid transactions snapshot.
+bool loadTransactionsFromSnapshot(const string& filename, TransactionLinkedListStore& store){
+    TransactionSnapshot snapshot;
+    if(!snapshot.open(filename)) return false;
+
+    for(size_t row = 0; row < snapshot.size(); row++){
+        Transaction t;
+        FieldView customerID = snapshot.customerID(row);
+        FieldView product = snapshot.product(row);
+        FieldView category = snapshot.category(row);
+        FieldView paymentMethod = snapshot.paymentMethod(row);
+        uint32_t key = snapshot.dateKey(row);
+        char date[16];
+        snprintf(date, sizeof(date), "%02u/%02u/%04u", dateKeyDay(key), dateKeyMonth(key), dateKeyYear(key));
+
+        t.customerID.assign(customerID.ptr, customerID.len);
+        t.product.assign(product.ptr, product.len);
+        t.price = snapshot.price(row);
+        t.date = date;
+        t.dateKey = key;
+        t.category.assign(category.ptr, category.len);
+        t.paymentMethod.assign(paymentMethod.ptr, paymentMethod.len);
+        store.insert(t);
+    }
+    return true;
+}
+
+bool loadReviewsFromSnapshot(const string& filename, ReviewLinkedListStore& store){
+    ReviewSnapshot snapshot;
+    if(!snapshot.open(filename)) return false;
+
+    for(size_t row = 0; row < snapshot.size(); row++){
+        Review r;
+        r.productID = snapshot.productID(row).toString();
+        r.customerID = snapshot.customerID(row).toString();
+        r.rating = snapshot.rating(row);
+        r.reviewText = snapshot.text(row).toString();
+        store.insert(r);
+    }
+    return true;
+}
+
 int main(){
+    // The cleaners' binary snapshots are used when present, the CSV files otherwise
     TransactionLinkedListStore transactions;
-    loadTransactionsFromCSV("C:\\Users\\User\\OneDrive - Asia Pacific University\\DSA\\DataStruck-1\\data\\transactionsClean.csv", transactions);
+    if(!loadTransactionsFromSnapshot("C:\\Users\\User\\OneDrive - Asia Pacific University\\DSA\\DataStruck-1\\data\\transactionsClean.snap", transactions)){
+        loadTransactionsFromCSVParallel("C:\\Users\\User\\OneDrive - Asia Pacific University\\DSA\\DataStruck-1\\data\\transactionsClean.csv", transactions);
+    }
 
     ReviewLinkedListStore reviews;
-    loadReviewsFromCSV("C:\\Users\\User\\OneDrive - Asia Pacific University\\DSA\\DataStruck-1\\data\\reviewsClean.csv", reviews);
+    if(!loadReviewsFromSnapshot("C:\\Users\\User\\OneDrive - Asia Pacific University\\DSA\\DataStruck-1\\data\\reviewsClean.snap", reviews)){
+        loadReviewsFromCSV("C:\\Users\\User\\OneDrive - Asia Pacific University\\DSA\\DataStruck-1\\data\\reviewsClean.csv", reviews);
+    }
 
     cout << "====== QUESTION 1 ======\n\n";
 
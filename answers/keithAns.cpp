@@ -1,6 +1,4 @@
 #include "keithAns.hpp"
-#include "../src/algorithms/KeithJumpSearch.cpp"
-#include "../src/algorithms/heapSort.cpp"
 
 // Main file containing only the main function (Q1, Q2, Q3)
 // All other functions, classes, and utilities are in keithAns.hpp
@@ -10,22 +8,48 @@
  */
 int main() {
     // --- Initialization ---
+    StringArena transactionStrings;            // Backs the strings of the linked list rows
+    StringArena reviewStrings;                 // Backs the strings of the reviews
+    NodePool<TransactionNode> transactionNodes; // Backs the linked list nodes
+    NodePool<Review> reviewNodes;
     TransactionNode* transactionsLL = nullptr; // Linked List head
     TransactionArray transactionsArray;        // Custom Array for array implementation
+    TransactionUnrolledList transactionsUnrolled; // Unrolled List: blocks of rows, linked
+    TransactionTable transactionsTable;        // Columnar copy for analytical scans
+    TransactionSnapshot transactionsSnapshot;  // Mapped binary snapshot, used instead when present
+    ReviewSnapshot reviewsSnapshot;
     Review* reviews = nullptr;             // Linked List for reviews
     WordFrequency* wordFreq = nullptr;     // Linked List for word analysis
 
     const std::string transactionFile = "../data/transactionsClean.csv";
     const std::string reviewFile = "../data/reviewsClean.csv";
+    const std::string transactionSnapshotFile = "../data/transactionsClean.snap";
+    const std::string reviewSnapshotFile = "../data/reviewsClean.snap";
 
     // --- Data Loading ---
     std::cout << "\n--- Loading Data ---" << std::endl;
-    readTransactionsFileLL(transactionFile, transactionsLL);
-    readTransactionsFileArray(transactionFile, transactionsArray); // Load into custom array
-    readReviewsFile(reviewFile, reviews);
-    std::cout << "Loaded " << countTransactionsLL(transactionsLL) << " transactions (LL) and "
-              << transactionsArray.size() << " transactions (Array)." << std::endl; // Use .size()
-    std::cout << "Loaded " << countReviews(reviews) << " reviews." << std::endl;
+    readTransactionsFileLL(transactionFile, transactionsLL, &transactionStrings, &transactionNodes);
+    readTransactionsFileArrayParallel(transactionFile, transactionsArray); // Load into custom array
+    readTransactionsFileUnrolled(transactionFile, transactionsUnrolled, &transactionStrings);
+
+    // Snapshots written by the cleaners are mapped as is; the CSV files
+    // are parsed only when there is no (valid) snapshot
+    auto startSnapshot = std::chrono::high_resolution_clock::now();
+    bool useTransactionSnapshot = transactionsSnapshot.open(transactionSnapshotFile);
+    bool useReviewSnapshot = reviewsSnapshot.open(reviewSnapshotFile);
+    auto endSnapshot = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> durationSnapshot = endSnapshot - startSnapshot;
+    if (useTransactionSnapshot || useReviewSnapshot) {
+        std::cout << "Mapped binary snapshot(s) in " << durationSnapshot.count() << " ms" << std::endl;
+    }
+
+    if (!useTransactionSnapshot) readTransactionsFileTable(transactionFile, transactionsTable);
+    if (!useReviewSnapshot) readReviewsFile(reviewFile, reviews, &reviewStrings, &reviewNodes);
+    size_t reviewTotal = useReviewSnapshot ? reviewsSnapshot.size() : (size_t)countReviews(reviews);
+    std::cout << "Loaded " << countTransactionsLL(transactionsLL) << " transactions (LL), "
+              << transactionsArray.size() << " transactions (Array) and "
+              << countTransactionsUnrolled(transactionsUnrolled) << " transactions (Unrolled List)." << std::endl;
+    std::cout << "Loaded " << reviewTotal << " reviews." << std::endl;
 
 
     // --- Requirement 3 & 6: Sorting and Performance Comparison ---
@@ -33,18 +57,25 @@ int main() {
 
     // Time Linked List Sort (Merge Sort by Date)
     auto startLLSort = std::chrono::high_resolution_clock::now();
-    // SortingAlgorithms::mergeSortLL removed; use HeapSort::sortTransactions or KeithJumpSearch(transactionsLL);
+    sortTransactionsLLByDate(transactionsLL);
     auto endLLSort = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> durationLLSort = endLLSort - startLLSort;
     std::cout << "Linked List Merge Sort Time: " << durationLLSort.count() << " ms" << std::endl;
 
     // Time Custom Array Sort (Merge Sort by Date)
     auto startArrSort = std::chrono::high_resolution_clock::now();
-    // SortingAlgorithms::mergeSortArray removed; use HeapSort or KeithJumpSearch(transactionsArray);
+    sortTransactionsArrayByDate(transactionsArray);
     auto endArrSort = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> durationArrSort = endArrSort - startArrSort;
     std::cout << "Custom Array Merge Sort Time:" << durationArrSort.count() << " ms" << std::endl;
 
+    // Time Unrolled List Sort (per-block insertion sort, then block merges)
+    auto startUnrolledSort = std::chrono::high_resolution_clock::now();
+    sortTransactionsUnrolledByDate(transactionsUnrolled);
+    auto endUnrolledSort = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> durationUnrolledSort = endUnrolledSort - startUnrolledSort;
+    std::cout << "Unrolled List Merge Sort Time: " << durationUnrolledSort.count() << " ms" << std::endl;
+
     // Display first few sorted transactions (from Custom Array for example)
     std::cout << "\nFirst 10 Transactions Sorted by Date (from Custom Array):" << std::endl;
     int displayCount = 0;
@@ -79,26 +110,114 @@ int main() {
      std::chrono::duration<double, std::milli> durationArrSearch = endArrSearch - startArrSearch;
      std::cout << "Custom Array Search Time: " << durationArrSearch.count() << " ms" << std::endl;
 
+     // Time Unrolled List Search
+     double percentageUnrolled;
+     auto startUnrolledSearch = std::chrono::high_resolution_clock::now();
+     percentageUnrolled = calculateElectronicsCreditCardPercentageUnrolled(transactionsUnrolled);
+     auto endUnrolledSearch = std::chrono::high_resolution_clock::now();
+     std::chrono::duration<double, std::milli> durationUnrolledSearch = endUnrolledSearch - startUnrolledSearch;
+     std::cout << "Unrolled List Search Time: " << durationUnrolledSearch.count() << " ms" << std::endl;
+
+     // Time Columnar Table Search
+     double percentageTable;
+     auto startTableSearch = std::chrono::high_resolution_clock::now();
+     percentageTable = useTransactionSnapshot ? calculateElectronicsCreditCardPercentageTable(transactionsSnapshot)
+                                              : calculateElectronicsCreditCardPercentageTable(transactionsTable);
+     auto endTableSearch = std::chrono::high_resolution_clock::now();
+     std::chrono::duration<double, std::milli> durationTableSearch = endTableSearch - startTableSearch;
+     std::cout << "Columnar Table Search Time: " << durationTableSearch.count() << " ms" << std::endl;
+
      std::cout << "\nPercentage (Linked List): " << std::fixed << std::setprecision(2) << percentageLL << "%" << std::endl;
      std::cout << "Percentage (Custom Array):" << std::fixed << std::setprecision(2) << percentageArr << "%" << std::endl;
+     std::cout << "Percentage (Unrolled List):" << std::fixed << std::setprecision(2) << percentageUnrolled << "%" << std::endl;
+     std::cout << "Percentage (Columnar Table):" << std::fixed << std::setprecision(2) << percentageTable << "%" << std::endl;
+
+     std::cout << "\nPayment methods by category (single pass over the table):" << std::endl;
+     if (useTransactionSnapshot) displayCategoryPaymentBreakdown(transactionsSnapshot);
+     else displayCategoryPaymentBreakdown(transactionsTable);
+
+     // Range queries through sorted indexes: built once, then O(log n) per
+     // query with no re-sort of the array
+     std::cout << "\n--- Range Queries (Sorted Indexes) ---" << std::endl;
+     auto startIndexBuild = std::chrono::high_resolution_clock::now();
+     SortedIndex dateIndex(RADIX_BY_DATE);
+     SortedIndex priceIndex(RADIX_BY_PRICE);
+     dateIndex.build(transactionsArray);
+     priceIndex.build(transactionsArray);
+     auto endIndexBuild = std::chrono::high_resolution_clock::now();
+     std::chrono::duration<double, std::milli> durationIndexBuild = endIndexBuild - startIndexBuild;
+     std::cout << "Index Build Time: " << durationIndexBuild.count() << " ms" << std::endl;
+     std::cout << "Search method: " << SearchAlgorithms::methodName(dateIndex.searchMethod()) << " (date), "
+               << SearchAlgorithms::methodName(priceIndex.searchMethod()) << " (price)" << std::endl;
+
+     auto startIndexQuery = std::chrono::high_resolution_clock::now();
+     displayIndexQueries(transactionsArray, dateIndex, priceIndex);
+     auto endIndexQuery = std::chrono::high_resolution_clock::now();
+     std::chrono::duration<double, std::milli> durationIndexQuery = endIndexQuery - startIndexQuery;
+     std::cout << "Index Query Time: " << durationIndexQuery.count() << " ms" << std::endl;
+
+     // Per-customer and per-product lookups through hash indexes. Review
+     // rows are snapshot rows, or list positions when the list is loaded.
+     std::cout << "\n--- Customer and Product Lookups (Hash Indexes) ---" << std::endl;
+     std::vector<Review*> reviewRows;
+     for (Review* review = reviews; review; review = review->next) reviewRows.push_back(review);
+
+     auto startHashBuild = std::chrono::high_resolution_clock::now();
+     HashIndex transactionsByCustomer;
+     HashIndex reviewsByProduct;
+     indexTransactionsByCustomer(transactionsArray, transactionsByCustomer);
+     if (useReviewSnapshot) {
+         indexNewRows(reviewsByProduct, reviewsSnapshot.size(),
+                      [&](size_t row) { return reviewsSnapshot.productID(row); });
+     } else {
+         indexNewRows(reviewsByProduct, reviewRows.size(), [&](size_t row) {
+             const MyString& id = reviewRows[row]->productID;
+             return FieldView(id.c_str(), id.size());
+         });
+     }
+     auto endHashBuild = std::chrono::high_resolution_clock::now();
+     std::chrono::duration<double, std::milli> durationHashBuild = endHashBuild - startHashBuild;
+     std::cout << "Hash Index Build Time: " << durationHashBuild.count() << " ms" << std::endl;
+     std::cout << "Indexed " << transactionsByCustomer.keyCount() << " customers and "
+               << reviewsByProduct.keyCount() << " reviewed products." << std::endl;
+
+     if (transactionsByCustomer.keyCount() > 0 && reviewsByProduct.keyCount() > 0) {
+         // Look up the busiest customer and the most reviewed product
+         const char* customerID = transactionsByCustomer.key(mostFrequentKey(transactionsByCustomer));
+         const char* productID = reviewsByProduct.key(mostFrequentKey(reviewsByProduct));
+
+         auto startHashLookup = std::chrono::high_resolution_clock::now();
+         displayIndexLookups(transactionsArray, transactionsByCustomer, reviewsByProduct,
+                             customerID, productID, [&](uint32_t row) {
+                                 return useReviewSnapshot ? reviewsSnapshot.rating(row) : reviewRows[row]->rating;
+                             });
+         auto endHashLookup = std::chrono::high_resolution_clock::now();
+         std::chrono::duration<double, std::milli> durationHashLookup = endHashLookup - startHashLookup;
+         std::cout << "Hash Index Lookup Time: " << durationHashLookup.count() << " ms" << std::endl;
+     }
 
 
     // --- Requirement 5: Review Analysis ---
     std::cout << "\n--- Analyzing 1-Star Reviews (Requirement 5) ---" << std::endl;
     // Count one-star reviews first
-    int oneStarCount = 0;
-    Review* reviewCurrent = reviews;
-    while (reviewCurrent) {
-        if (reviewCurrent->rating == 1) oneStarCount++;
-        reviewCurrent = reviewCurrent->next;
+    size_t oneStarCount = 0;
+    if (useReviewSnapshot) {
+        oneStarCount = reviewsSnapshot.countRating(1);
+    } else {
+        Review* reviewCurrent = reviews;
+        while (reviewCurrent) {
+            if (reviewCurrent->rating == 1) oneStarCount++;
+            reviewCurrent = reviewCurrent->next;
+        }
     }
 
-    // Use existing functions for review analysis
-    findOneStarReviewWords(reviews, wordFreq);
+    // Use existing functions for review analysis, counted in parallel shards
+    if (useReviewSnapshot) findOneStarReviewWords(reviewsSnapshot, wordFreq, 0);
+    else findOneStarReviewWords(reviews, wordFreq, 0);
     sortWordsByFrequency(wordFreq); // Sorts the WordFrequency linked list
 
     std::cout << "\nAnalyzed " << oneStarCount << " one-star reviews out of "
-              << countReviews(reviews) << " total reviews." << std::endl;
+              << reviewTotal << " total reviews." << std::endl;
     int uniqueWordCount = countWordFrequency(wordFreq); // Count unique words after merging/sorting
     std::cout << "Found " << uniqueWordCount << " unique meaningful words/symbols in 1-star reviews." << std::endl;
     std::cout << "\nTop 10 most frequent words/symbols in 1-star reviews:" << std::endl;
@@ -107,24 +226,19 @@ int main() {
 
     // --- Cleanup ---
     std::cout << "\n--- Cleaning Up Memory ---" << std::endl;
-    // Clean up linked list transactions
-    while (transactionsLL) {
-        TransactionNode* temp = transactionsLL;
-        transactionsLL = transactionsLL->next;
-        delete temp;
-    }
+    // Clean up linked list transactions. The nodes live in a pool and their
+    // strings in an arena, so the whole list goes in one pass over the chunks.
+    transactionNodes.release();
+    transactionsLL = nullptr;
     std::cout << "Cleaned up transaction linked list." << std::endl;
 
     // Custom Array cleans itself up via destructor (RAII)
      std::cout << "Transaction custom array cleaned up automatically via destructor." << std::endl;
 
 
-    // Clean up linked list reviews
-    while (reviews) {
-        Review* temp = reviews;
-        reviews = reviews->next;
-        delete temp;
-    }
+    // Clean up linked list reviews (pooled, like the transactions)
+    reviewNodes.release();
+    reviews = nullptr;
      std::cout << "Cleaned up review linked list." << std::endl;
 
     // Clean up linked list word frequencies
@@ -7,6 +7,19 @@
 #include <sstream>
 #include "../src/algorithms/KeithJumpSearch.cpp"
 #include "../src/algorithms/heapSort.cpp"
+#include "../src/algorithms/SortingAlgorithms.cpp"
+#include "../src/algorithms/radixSort.cpp"
+#include "../include/csvReader.hpp"
+#include "../include/wordCounter.hpp"
+#include "../include/parallelWordCount.hpp"
+#include "../include/tokenizer.hpp"
+#include "../include/fuzzyMerge.hpp"
+#include "../include/transactionTable.hpp"
+#include "../include/snapshot.hpp"
+#include "../include/nodePool.hpp"
+#include "../include/unrolledList.hpp"
+#include "../include/sortedIndex.hpp"
+#include "../include/hashIndex.hpp"
 #include <cctype>     
 #include <chrono>
 #include <stdexcept>
@@ -24,329 +37,322 @@ struct WordNode {
     WordNode() : frequency(0), next(nullptr) {}
 };
 
-// Helper function to split string into words
-inline void splitIntoWords(const char* text, WordFrequency*& wordFreq) {
-    std::string stdText(text);
-    std::string stdWord;
-    std::istringstream iss(stdText);
-    
-    while (iss >> stdWord) {
-        // Convert to lowercase and remove punctuation
-        std::string cleanStdWord;
-        for (char c : stdWord) {
-            if (isalpha(c)) {
-                cleanStdWord += tolower(c);
-            }
-        }
-        
-        if (cleanStdWord.empty()) continue;
-        
-        // Convert to MyString for comparison
-        MyString cleanWord(cleanStdWord.c_str());
-        
-        // Update word frequency
-        WordFrequency* current = wordFreq;
-        bool found = false;
-        
-        while (current) {
-            if (current->word == cleanWord) {
-                current->frequency++;
-                found = true;
-                break;
-            }
-            current = current->next;
+// Helper function to split string into words and count them.
+// Each whitespace-separated token keeps only its letters, lowercased.
+inline void splitIntoWords(const char* text, WordCounter& counts) {
+    Tokenizer::forEachToken(text, strlen(text), Tokenizer::NON_SPACE, [&](const char* token, size_t len) {
+        TokenBuffer cleanWord(token, len, Tokenizer::LETTER);
+        if (!cleanWord.empty()) {
+            counts.add(cleanWord.data(), cleanWord.size());
         }
-        
-        if (!found) {
-            // Add new word to the list
-            WordFrequency* newWord = new WordFrequency;
-            newWord->word = cleanWord;
-            newWord->frequency = 1;
-            newWord->next = wordFreq;
-            wordFreq = newWord;
-        }
-    }
+    });
 }
 
-// Implementation of merge sort for transactions (Linked List by Date)
-inline TransactionNode* merge(TransactionNode* left, TransactionNode* right) {
-    TransactionNode* result = nullptr;
-    
-    // Base cases
-    if (!left) return right;
-    if (!right) return left;
-    
-    // Compare dates and merge
-    if (left->date <= right->date) {
-        result = left;
-        result->next = merge(left->next, right);
+// Sort the linked list by date (bottom-up merge sort, no recursion)
+inline void sortTransactionsLLByDate(TransactionNode*& head) {
+    SortingAlgorithms::mergeSortLL(head);
+}
+
+// Transactions in blocks of 64 rows: list-style splicing and insertion
+// with close to array-speed scans
+typedef UnrolledList<TransactionData, 64> TransactionUnrolledList;
+
+// Sort the unrolled list by date (stable, same order as the other sorts)
+inline void sortTransactionsUnrolledByDate(TransactionUnrolledList& transactions) {
+    transactions.sort([](const TransactionData& a, const TransactionData& b) {
+        return a.dateKey < b.dateKey;
+    });
+}
+
+// Wrapper function to sort the custom TransactionArray by date
+inline void sortTransactionsArrayByDate(TransactionArray& transactions) {
+    SortingAlgorithms::mergeSortArray(transactions);
+}
+
+// Copies a field into a MyString, into the arena when one is given
+inline void assignField(MyString& target, const FieldView& field, StringArena* arena) {
+    if (arena) {
+        target.assign(field.ptr, field.len, *arena);
     } else {
-        result = right;
-        result->next = merge(left, right->next);
+        target.assign(field.ptr, field.len);
     }
-    
-    return result;
 }
 
-inline void split(TransactionNode* source, TransactionNode*& left, TransactionNode*& right) {
-    if (!source || !source->next) {
-        left = source;
-        right = nullptr;
-        return;
-    }
-    
-    // Use slow and fast pointers to find the middle
-    TransactionNode* slow = source;
-    TransactionNode* fast = source->next;
-    
-    // Fast moves twice as fast as slow
-    while (fast) {
-        fast = fast->next;
-        if (fast) {
-            slow = slow->next;
-            fast = fast->next;
-        }
+// Copies one parsed row of field views into a transaction record.
+// Works for both TransactionNode and TransactionData.
+template <typename Record>
+inline void assignTransactionFields(Record& record, const FieldView* fields, StringArena* arena) {
+    assignField(record.customerID, fields[TX_CUSTOMER], arena);
+    assignField(record.product, fields[TX_PRODUCT], arena);
+
+    if (!parseDouble(fields[TX_PRICE], record.price)) {
+        std::cerr << "Invalid price format: " << fields[TX_PRICE].toString() << std::endl;
+        record.price = 0.0; // Default value
     }
-    
-    // Split the list into two halves
-    left = source;
-    right = slow->next;
-    slow->next = nullptr; // Terminate first half
+
+    assignField(record.date, fields[TX_DATE], arena);
+    record.dateKey = parseDateKey(fields[TX_DATE].ptr, fields[TX_DATE].len);
+    assignField(record.category, fields[TX_CATEGORY], arena);
+    assignField(record.paymentMethod, fields[TX_PAYMENT], arena);
 }
 
+// Calls onRow(fields) for every valid line in [begin, end)
+template <typename RowHandler>
+inline void parseTransactionRows(const TransactionLayout& layout, const char* begin, const char* end,
+                                 RowHandler onRow) {
+    LineCursor cursor(begin, end);
+    FieldView line;
+    FieldView fields[TX_FIELD_COUNT];
 
+    while (cursor.next(line)) {
+        if (line.empty()) continue;
 
-// Merge function for TransactionData arrays (sorted by date)
-inline void mergeArrays(TransactionData* arr, size_t left, size_t mid, size_t right) {
-    size_t n1 = mid - left + 1;
-    size_t n2 = right - mid;
-    
-    // Create temporary arrays
-    TransactionData* L = new TransactionData[n1];
-    TransactionData* R = new TransactionData[n2];
-    
-    // Copy data to temporary arrays L[] and R[]
-    for (size_t i = 0; i < n1; i++)
-        L[i] = arr[left + i];
-    for (size_t j = 0; j < n2; j++)
-        R[j] = arr[mid + 1 + j];
-    
-    // Merge the temporary arrays back into arr[left..right]
-    size_t i = 0, j = 0, k = left;
-    while (i < n1 && j < n2) {
-        if (L[i].date <= R[j].date) {
-            arr[k] = L[i];
-            i++;
+        // Ensure we have all required fields
+        if (layout.split(line, fields)) {
+            onRow(fields);
         } else {
-            arr[k] = R[j];
-            j++;
+            std::cerr << "Invalid line format: " << line.toString() << std::endl;
         }
-        k++;
     }
-    
-    // Copy the remaining elements of L[], if any
-    while (i < n1) {
-        arr[k] = L[i];
-        i++;
-        k++;
+}
+
+// Maps a transactions file and reads its header. On success body points
+// just past the header line and layout matches the file's columns.
+inline bool openTransactionsFile(const std::string& filename, MappedFile& file,
+                                 TransactionLayout& layout, const char*& body) {
+    if (!file.open(filename)) {
+        std::cerr << "Error opening file: " << filename << std::endl;
+        return false;
     }
-    
-    // Copy the remaining elements of R[], if any
-    while (j < n2) {
-        arr[k] = R[j];
-        j++;
-        k++;
+
+    LineCursor cursor(file.begin(), file.end());
+    FieldView header;
+    if (cursor.next(header)) {
+        layout.fromHeader(header);
     }
-    
-    // Free temporary arrays
-    delete[] L;
-    delete[] R;
+    body = cursor.position();
+    return true;
 }
 
-// Main Merge Sort function for TransactionData arrays (recursive)
-inline void mergeSortArrayRecursive(TransactionData* arr, size_t left, size_t right) {
-    if (left < right) {
-        size_t mid = left + (right - left) / 2;
-        
-        // Sort first and second halves
-        mergeSortArrayRecursive(arr, left, mid);
-        mergeSortArrayRecursive(arr, mid + 1, right);
-        
-        // Merge the sorted halves
-        mergeArrays(arr, left, mid, right);
-    }
+// Calls onRow(fields) for every valid line of a mapped transactions file.
+// The header decides the column layout; fields are views into the mapping.
+template <typename RowHandler>
+inline bool forEachTransactionRow(const std::string& filename, RowHandler onRow) {
+    MappedFile file;
+    TransactionLayout layout;
+    const char* body = nullptr;
+    if (!openTransactionsFile(filename, file, layout, body)) return false;
+
+    parseTransactionRows(layout, body, file.end(), onRow);
+    return true;
 }
 
-// Wrapper function to sort the custom TransactionArray by date
-inline void sortTransactionsArrayByDate(TransactionArray& transactions) {
-    if (transactions.size() > 1) {
-        mergeSortArrayRecursive(transactions.getDataPtr(), 0, transactions.size() - 1);
-    }
+// Allocates a list node from the pool when one is given, with new otherwise
+template <typename Node>
+inline Node* allocateNode(NodePool<Node>* pool) {
+    return pool ? pool->create() : new Node;
 }
 
-// Read transactions into a Linked List
-inline void readTransactionsFileLL(const std::string& filename, TransactionNode*& head) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error opening file: " << filename << std::endl;
-        return;
-    }
-    
-    std::string line;
-    // Skip header line
-    std::getline(file, line);
-    
-    TransactionNode* tail = nullptr; // For appending to the end
-    
-    while (std::getline(file, line)) {
-        std::istringstream iss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-        
-        // Split line by comma
-        while (std::getline(iss, token, ',')) {
-            tokens.push_back(token);
+// Read transactions into a Linked List. With an arena the node strings are
+// handles into it, so the arena must outlive the list. With a pool the
+// nodes come from it (and are freed with it) instead of from new.
+inline void readTransactionsFileLL(const std::string& filename, TransactionNode*& head,
+                                   StringArena* arena = nullptr, NodePool<TransactionNode>* pool = nullptr) {
+    TransactionNode* tail = head; // For appending to the end
+    while (tail && tail->next) tail = tail->next;
+
+    forEachTransactionRow(filename, [&](const FieldView* fields) {
+        TransactionNode* newNode = allocateNode(pool);
+        assignTransactionFields(*newNode, fields, arena);
+        newNode->next = nullptr;
+
+        // Add to linked list
+        if (!head) {
+            head = newNode;
+            tail = newNode;
+        } else {
+            tail->next = newNode;
+            tail = newNode;
         }
-        
-        // Ensure we have all required fields
-        if (tokens.size() >= 6) {
-            TransactionNode* newNode = new TransactionNode;
-            
-            // Parse and store transaction data
-            newNode->customerID = tokens[0].c_str();
-            newNode->product = tokens[1].c_str();
-            
-            // Convert price from string to double
-            try {
-                newNode->price = std::stod(tokens[2]);
-            } catch (const std::invalid_argument& e) {
-                std::cerr << "Invalid price format: " << tokens[2] << std::endl;
-                newNode->price = 0.0; // Default value
-            }
-            
-            newNode->date = tokens[3].c_str();
-            newNode->category = tokens[4].c_str();
-            newNode->paymentMethod = tokens[5].c_str();
-            
+    });
+}
+
+// Read transactions into an unrolled list. With an arena the row strings
+// are handles into it, so the arena must outlive the list.
+inline void readTransactionsFileUnrolled(const std::string& filename, TransactionUnrolledList& transactions,
+                                         StringArena* arena = nullptr) {
+    forEachTransactionRow(filename, [&](const FieldView* fields) {
+        TransactionData& transaction = transactions.emplace_back();
+        assignTransactionFields(transaction, fields, arena);
+    });
+}
+
+// Read transactions into a Custom Array (TransactionArray).
+// Strings are stored in the array's own arena.
+inline void readTransactionsFileArray(const std::string& filename, TransactionArray& transactions) {
+    forEachTransactionRow(filename, [&](const FieldView* fields) {
+        // Construct the row directly in the custom array
+        TransactionData& transaction = transactions.emplace_back();
+        assignTransactionFields(transaction, fields, &transactions.getArena());
+    });
+}
+
+// Parallel version of readTransactionsFileArray. Each worker parses a
+// newline-aligned byte range into its own array; the arrays are then
+// appended in file order, so row order and count match the serial loader.
+// workers == 0 uses one worker per hardware thread.
+inline void readTransactionsFileArrayParallel(const std::string& filename, TransactionArray& transactions,
+                                              unsigned workers = 0) {
+    MappedFile file;
+    TransactionLayout layout;
+    const char* body = nullptr;
+    if (!openTransactionsFile(filename, file, layout, body)) return;
+
+    std::vector<const char*> bounds;
+    size_t chunks = splitLineAlignedChunks(body, file.end(), workers == 0 ? defaultWorkerCount() : workers, bounds);
+    std::vector<TransactionArray> parts(chunks);
+
+    parallelForChunks(bounds, [&](size_t chunk, const char* begin, const char* end) {
+        TransactionArray& local = parts[chunk];
+        parseTransactionRows(layout, begin, end, [&](const FieldView* fields) {
+            TransactionData& transaction = local.emplace_back();
+            assignTransactionFields(transaction, fields, &local.getArena());
+        });
+    });
+
+    size_t total = transactions.size();
+    for (size_t chunk = 0; chunk < parts.size(); chunk++) total += parts[chunk].size();
+    transactions.reserve(total);
+
+    // Rows are moved, and the worker arenas move into the result
+    for (size_t chunk = 0; chunk < parts.size(); chunk++) {
+        for (size_t i = 0; i < parts[chunk].size(); i++) {
+            transactions.push_back(std::move(parts[chunk][i]));
+        }
+        transactions.getArena().absorb(parts[chunk].getArena());
+    }
+}
+
+// Parallel version of readTransactionsFileLL. Each worker builds its own
+// chain; the chains are spliced together in file order.
+inline void readTransactionsFileLLParallel(const std::string& filename, TransactionNode*& head,
+                                           unsigned workers = 0, StringArena* arena = nullptr,
+                                           NodePool<TransactionNode>* pool = nullptr) {
+    MappedFile file;
+    TransactionLayout layout;
+    const char* body = nullptr;
+    if (!openTransactionsFile(filename, file, layout, body)) return;
+
+    std::vector<const char*> bounds;
+    size_t chunks = splitLineAlignedChunks(body, file.end(), workers == 0 ? defaultWorkerCount() : workers, bounds);
+    std::vector<TransactionNode*> chainHeads(chunks, nullptr);
+    std::vector<TransactionNode*> chainTails(chunks, nullptr);
+    std::vector<StringArena> arenas(arena ? chunks : 0);
+    std::vector<NodePool<TransactionNode>> pools(pool ? chunks : 0);
+
+    parallelForChunks(bounds, [&](size_t chunk, const char* begin, const char* end) {
+        TransactionNode*& localHead = chainHeads[chunk];
+        TransactionNode*& localTail = chainTails[chunk];
+        parseTransactionRows(layout, begin, end, [&](const FieldView* fields) {
+            TransactionNode* newNode = allocateNode(pool ? &pools[chunk] : nullptr);
+            assignTransactionFields(*newNode, fields, arena ? &arenas[chunk] : nullptr);
             newNode->next = nullptr;
-            
-            // Add to linked list
-            if (!head) {
-                head = newNode;
-                tail = newNode;
+
+            if (!localHead) {
+                localHead = newNode;
             } else {
-                tail->next = newNode;
-                tail = newNode;
+                localTail->next = newNode;
             }
+            localTail = newNode;
+        });
+    });
+
+    // Splice the per-worker chains onto the end of the list
+    TransactionNode* tail = head;
+    while (tail && tail->next) tail = tail->next;
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        if (!chainHeads[chunk]) continue;
+        if (!head) {
+            head = chainHeads[chunk];
         } else {
-            std::cerr << "Invalid line format: " << line << std::endl;
+            tail->next = chainHeads[chunk];
         }
+        tail = chainTails[chunk];
+    }
+    for (size_t chunk = 0; chunk < arenas.size(); chunk++) {
+        arena->absorb(arenas[chunk]);
+    }
+    for (size_t chunk = 0; chunk < pools.size(); chunk++) {
+        pool->absorb(pools[chunk]);
     }
-    
-    file.close();
 }
 
-// Read transactions into a Custom Array (TransactionArray)
-inline void readTransactionsFileArray(const std::string& filename, TransactionArray& transactions) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error opening file: " << filename << std::endl;
-        return;
-    }
-    
-    std::string line;
-    // Skip header line
-    std::getline(file, line);
-    
-    while (std::getline(file, line)) {
-        std::istringstream iss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-        
-        // Split line by comma
-        while (std::getline(iss, token, ',')) {
-            tokens.push_back(token);
-        }
-        
-        // Ensure we have all required fields
-        if (tokens.size() >= 6) {
-            TransactionData transaction;
-            
-            // Parse and store transaction data
-            transaction.customerID = tokens[0].c_str();
-            transaction.product = tokens[1].c_str();
-            
-            // Convert price from string to double
-            try {
-                transaction.price = std::stod(tokens[2]);
-            } catch (const std::invalid_argument& e) {
-                std::cerr << "Invalid price format: " << tokens[2] << std::endl;
-                transaction.price = 0.0; // Default value
-            }
-            
-            transaction.date = tokens[3].c_str();
-            transaction.category = tokens[4].c_str();
-            transaction.paymentMethod = tokens[5].c_str();
-            
-            // Add to custom array
-            transactions.push_back(transaction);
-        } else {
-            std::cerr << "Invalid line format: " << line << std::endl;
+// Read transactions into a columnar TransactionTable, straight from the
+// mapped file's field views
+inline void readTransactionsFileTable(const std::string& filename, TransactionTable& table) {
+    forEachTransactionRow(filename, [&](const FieldView* fields) {
+        double price = 0.0;
+        if (!parseDouble(fields[TX_PRICE], price)) {
+            std::cerr << "Invalid price format: " << fields[TX_PRICE].toString() << std::endl;
+            price = 0.0; // Default value
         }
+        table.append(fields[TX_CUSTOMER], fields[TX_PRODUCT], fields[TX_CATEGORY], price,
+                     parseDateKey(fields[TX_DATE].ptr, fields[TX_DATE].len), fields[TX_PAYMENT]);
+    });
+}
+
+// Copies the rows of a TransactionArray into a columnar table, in order
+inline void buildTransactionTable(const TransactionArray& transactions, TransactionTable& table) {
+    table.reserve(table.size() + transactions.size());
+    for (size_t i = 0; i < transactions.size(); i++) {
+        const TransactionData& row = transactions[i];
+        table.append(FieldView(row.customerID.c_str(), row.customerID.size()),
+                     FieldView(row.product.c_str(), row.product.size()),
+                     FieldView(row.category.c_str(), row.category.size()),
+                     row.price, row.dateKey,
+                     FieldView(row.paymentMethod.c_str(), row.paymentMethod.size()));
     }
-    
-    file.close();
 }
 
-// Keep readReviewsFile as is, assuming Review struct is appropriate
-inline void readReviewsFile(const std::string& filename, Review*& head) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+// Review text is the last field and may contain commas.
+// With an arena the review strings are handles into it; with a pool the
+// nodes come from it.
+inline void readReviewsFile(const std::string& filename, Review*& head, StringArena* arena = nullptr,
+                            NodePool<Review>* pool = nullptr) {
+    MappedFile file;
+    if (!file.open(filename)) {
         std::cerr << "Error opening file: " << filename << std::endl;
         return;
     }
-    
-    std::string line;
+
+    LineCursor cursor(file.begin(), file.end());
+    FieldView line;
     // Skip header line
-    std::getline(file, line);
-    
-    Review* tail = nullptr; // For appending to the end
-    
-    while (std::getline(file, line)) {
-        std::istringstream iss(line);
-        std::string token;
-        std::vector<std::string> tokens;
-        
-        // Split line by comma, but preserve commas in the review text
-        // This assumes review text is the last field and may contain commas
-        for (int i = 0; i < 3 && std::getline(iss, token, ','); i++) {
-            tokens.push_back(token);
-        }
-        
-        // Get the rest as review text (may contain commas)
-        std::string reviewText;
-        if (std::getline(iss, reviewText)) {
-            tokens.push_back(reviewText);
-        }
-        
+    cursor.next(line);
+
+    Review* tail = head; // For appending to the end
+    while (tail && tail->next) tail = tail->next;
+
+    FieldView fields[4];
+    while (cursor.next(line)) {
+        if (line.empty()) continue;
+
         // Ensure we have all required fields
-        if (tokens.size() >= 4) {
-            Review* newReview = new Review;
-            
-            newReview->productID = tokens[0].c_str();
-            newReview->customerID = tokens[1].c_str();
-            
-            // Convert rating from string to int
-            try {
-                newReview->rating = std::stoi(tokens[2]);
-            } catch (const std::invalid_argument& e) {
-                std::cerr << "Invalid rating format: " << tokens[2] << std::endl;
+        if (splitFields(line, ',', fields, 4) == 4) {
+            Review* newReview = allocateNode(pool);
+
+            assignField(newReview->productID, fields[0], arena);
+            assignField(newReview->customerID, fields[1], arena);
+
+            // Convert rating from text to int
+            if (!parseInt(fields[2], newReview->rating)) {
+                std::cerr << "Invalid rating format: " << fields[2].toString() << std::endl;
                 newReview->rating = 0; // Default value
             }
-            
-            newReview->reviewText = tokens[3].c_str();
+
+            assignField(newReview->reviewText, fields[3], arena);
             newReview->next = nullptr;
-            
+
             // Add to linked list
             if (!head) {
                 head = newReview;
@@ -356,11 +362,9 @@ inline void readReviewsFile(const std::string& filename, Review*& head) {
                 tail = newReview;
             }
         } else {
-            std::cerr << "Invalid review line format: " << line << std::endl;
+            std::cerr << "Invalid review line format: " << line.toString() << std::endl;
         }
     }
-    
-    file.close();
 }
 
 // Counting functions
@@ -378,6 +382,10 @@ inline size_t countTransactionsArray(const TransactionArray& transactions) {
     return transactions.size();
 }
 
+inline size_t countTransactionsUnrolled(const TransactionUnrolledList& transactions) {
+    return transactions.size();
+}
+
 inline int countReviews(Review* head) {
     int count = 0;
     Review* current = head;
@@ -426,6 +434,136 @@ inline double calculateElectronicsCreditCardPercentageArray(const TransactionArr
     return (electronicsCreditCard * 100.0) / electronicsTotal;
 }
 
+// Calculate percentage (Unrolled List version); walks one block of rows at
+// a time
+inline double calculateElectronicsCreditCardPercentageUnrolled(const TransactionUnrolledList& transactions) {
+    int electronicsTotal = 0;
+    int electronicsCreditCard = 0;
+
+    transactions.forEachBlock([&](const TransactionData* rows, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            if (rows[i].category == "Electronics") {
+                electronicsTotal++;
+                if (rows[i].paymentMethod == "Credit Card") {
+                    electronicsCreditCard++;
+                }
+            }
+        }
+    });
+
+    if (electronicsTotal == 0) return 0.0;
+    return (electronicsCreditCard * 100.0) / electronicsTotal;
+}
+
+// Answers date and price range queries from the sorted indexes; the
+// array itself is only read for the rows that are printed
+inline void displayIndexQueries(const TransactionArray& transactions, const SortedIndex& byDate,
+                                const SortedIndex& byPrice) {
+    if (transactions.size() == 0) return;
+
+    std::cout << "Transactions in 2023: " << byDate.count(20230101, 20231231) << std::endl;
+    std::cout << "Transactions in March 2023: " << byDate.count(20230301, 20230331) << std::endl;
+    std::cout << "Transactions priced $100.00 - $500.00: "
+              << byPrice.count(SortedIndex::priceKey(100.0), SortedIndex::priceKey(500.0)) << std::endl;
+
+    const TransactionData& median = transactions[byPrice.kth(byPrice.size() / 2)];
+    const TransactionData& top = transactions[byPrice.kth(byPrice.size() - 1)];
+    std::cout << "Median price: $" << std::fixed << std::setprecision(2) << median.price
+              << " (" << median.product << ")" << std::endl;
+    std::cout << "Highest price: $" << std::fixed << std::setprecision(2) << top.price
+              << " (" << top.product << ")" << std::endl;
+}
+
+// Indexes rows [index.rowCount(), rowCount) under keyOf(row), a FieldView.
+// The first call indexes everything; after rows are appended to the store,
+// calling it again adds just the new rows.
+template <typename KeyOf>
+inline void indexNewRows(HashIndex& index, size_t rowCount, KeyOf keyOf) {
+    index.reserve(rowCount);
+    for (size_t row = index.rowCount(); row < rowCount; row++) {
+        index.add(keyOf(row));
+    }
+}
+
+inline void indexTransactionsByCustomer(const TransactionArray& transactions, HashIndex& byCustomer) {
+    indexNewRows(byCustomer, transactions.size(), [&](size_t row) {
+        const MyString& id = transactions[row].customerID;
+        return FieldView(id.c_str(), id.size());
+    });
+}
+
+// Id of the key with the most rows (the first such key on ties); the index
+// must not be empty
+inline uint32_t mostFrequentKey(const HashIndex& index) {
+    uint32_t best = 0;
+    for (uint32_t id = 1; id < index.keyCount(); id++) {
+        if (index.rowsOf(id).size() > index.rowsOf(best).size()) best = id;
+    }
+    return best;
+}
+
+// Prints what the indexes hold for one customer and one product; each
+// lookup reads only that key's rows
+template <typename RatingOf>
+inline void displayIndexLookups(const TransactionArray& transactions, const HashIndex& byCustomer,
+                                const HashIndex& reviewsByProduct, const char* customerID,
+                                const char* productID, RatingOf ratingOf) {
+    double spent = 0.0;
+    PostingList purchases = byCustomer.find(customerID);
+    for (uint32_t row : purchases) spent += transactions[row].price;
+    std::cout << "Customer " << customerID << ": " << purchases.size() << " transaction(s), $"
+              << std::fixed << std::setprecision(2) << spent << " total" << std::endl;
+
+    int ratingSum = 0;
+    PostingList productReviews = reviewsByProduct.find(productID);
+    for (uint32_t row : productReviews) ratingSum += ratingOf(row);
+    std::cout << "Product " << productID << ": " << productReviews.size() << " review(s)";
+    if (!productReviews.empty()) {
+        std::cout << ", average rating " << std::fixed << std::setprecision(2)
+                  << (double)ratingSum / productReviews.size();
+    }
+    std::cout << std::endl;
+}
+
+// Calculate percentage (columnar version); reads only the category and
+// payment method columns. Table is a TransactionTable or a mapped
+// TransactionSnapshot.
+template <typename Table>
+inline double calculateElectronicsCreditCardPercentageTable(const Table& table) {
+    size_t electronicsTotal = 0;
+    size_t electronicsCreditCard = 0;
+    table.countCategoryPayment("Electronics", "Credit Card", electronicsTotal, electronicsCreditCard);
+
+    if (electronicsTotal == 0) return 0.0;
+    return (electronicsCreditCard * 100.0) / electronicsTotal;
+}
+
+// Prints, for every category, how many purchases used each payment method
+// and their share of the category. The whole table is one pass.
+template <typename Table>
+inline void displayCategoryPaymentBreakdown(const Table& table) {
+    size_t categories = table.categoryCount();
+    size_t payments = table.paymentMethodCount();
+    std::vector<size_t> counts(categories * payments);
+    table.crossTabCategoryPayment(counts.data());
+
+    for (size_t c = 0; c < categories; c++) {
+        size_t categoryTotal = 0;
+        for (size_t p = 0; p < payments; p++) categoryTotal += counts[c * payments + p];
+        if (categoryTotal == 0) continue;
+
+        std::cout << table.categoryName((typename Table::CategoryCode)c).toString()
+                  << " (" << categoryTotal << " purchases)" << std::endl;
+        for (size_t p = 0; p < payments; p++) {
+            size_t count = counts[c * payments + p];
+            std::cout << "  " << std::left << std::setw(16)
+                      << table.paymentMethodName((typename Table::PaymentCode)p).toString() << std::right
+                      << std::setw(6) << count << "  " << std::fixed << std::setprecision(2)
+                      << (count * 100.0) / categoryTotal << "%" << std::endl;
+        }
+    }
+}
+
 // Checks if a character is a symbol (non-alphanumeric and non-space)
 inline bool isSymbol(char c) {
     return !isalnum(c) && !isspace(c);
@@ -433,251 +571,213 @@ inline bool isSymbol(char c) {
 
 // Normalizes a word by removing symbols and converting to lowercase
 inline MyString normalizeWord(const MyString& word) {
-    std::string stdWord = word.c_str();
-    std::string normalized;
-    
-    for (char c : stdWord) {
-        if (isalpha(c)) {
-            normalized += tolower(c);
-        }
-    }
-    
-    return MyString(normalized.c_str());
+    TokenBuffer normalized(word.c_str(), word.size(), Tokenizer::LETTER);
+    return MyString(normalized.data(), normalized.size());
 }
 
-// Checks if two words are similar using a simple distance metric
+// Checks if two words are similar: Levenshtein distance within maxDistance
 inline bool areWordsSimilar(const MyString& word1, const MyString& word2, int maxDistance = 2) {
-    std::string s1 = word1.c_str();
-    std::string s2 = word2.c_str();
-    
-    // If length difference is too great, words are not similar
-    if (abs((int)s1.length() - (int)s2.length()) > maxDistance) {
-        return false;
-    }
-    
-    // Simple character-by-character comparison
-    int differences = 0;
-    size_t minLength = std::min(s1.length(), s2.length());
-    
-    for (size_t i = 0; i < minLength; i++) {
-        if (s1[i] != s2[i]) differences++;
-        if (differences > maxDistance) return false;
-    }
-    
-    // Add remaining length difference to differences
-    differences += abs((int)s1.length() - (int)s2.length());
-    
-    return differences <= maxDistance;
+    return levenshteinDistance(word1.c_str(), word1.size(), word2.c_str(), word2.size(),
+                               maxDistance) <= maxDistance;
 }
 
-// Process text to extract words and symbols
-inline void processText(const char* text, WordFrequency*& wordFreq) {
-    std::string stdText = text;
-    std::string currentWord;
-    
-    for (size_t i = 0; i < stdText.length(); i++) {
-        char c = stdText[i];
-        
-        if (isalpha(c)) {
-            // Part of a word
-            currentWord += c;
-        } else {
-            // End of word or symbol
-            if (!currentWord.empty()) {
-                // Process completed word
-                MyString word(currentWord.c_str());
-                MyString normalizedWord = normalizeWord(word);
-                
-                // Skip very short words (likely not meaningful)
-                if (std::string(normalizedWord.c_str()).length() > 1) {
-                    // Update word frequency
-                    WordFrequency* current = wordFreq;
-                    bool found = false;
-                    
-                    while (current) {
-                        if (current->word == normalizedWord) {
-                            current->frequency++;
-                            found = true;
-                            break;
-                        }
-                        current = current->next;
-                    }
-                    
-                    if (!found) {
-                        // Add new word to the list
-                        WordFrequency* newWord = new WordFrequency;
-                        newWord->word = normalizedWord;
-                        newWord->frequency = 1;
-                        newWord->next = wordFreq;
-                        wordFreq = newWord;
-                    }
-                }
-                
-                currentWord.clear();
+// Process text to extract words and symbols. Words are runs of letters,
+// lowercased; every symbol character is counted on its own.
+inline void processText(const char* text, size_t length, WordCounter& counts) {
+    Tokenizer::forEachToken(text, length, Tokenizer::LETTER,
+        [&](const char* token, size_t len) {
+            // Skip very short words (likely not meaningful)
+            if (len > 1) {
+                TokenBuffer word(token, len, Tokenizer::LETTER);
+                counts.add(word.data(), word.size());
             }
-            
-            // Process symbol if it's not whitespace
-            if (isSymbol(c)) {
-                std::string symbolStr(1, c);
-                MyString symbol(symbolStr.c_str());
-                
-                // Update symbol frequency
-                WordFrequency* current = wordFreq;
-                bool found = false;
-                
-                while (current) {
-                    if (current->word == symbol) {
-                        current->frequency++;
-                        found = true;
-                        break;
-                    }
-                    current = current->next;
-                }
-                
-                if (!found) {
-                    // Add new symbol to the list
-                    WordFrequency* newSymbol = new WordFrequency;
-                    newSymbol->word = symbol;
-                    newSymbol->frequency = 1;
-                    newSymbol->next = wordFreq;
-                    wordFreq = newSymbol;
-                }
-            }
-        }
+        },
+        [&](char symbol) {
+            counts.add(&symbol, (size_t)1);
+        });
+}
+
+inline void processText(const char* text, WordCounter& counts) {
+    processText(text, strlen(text), counts);
+}
+
+// Builds a WordFrequency list from the counts, most frequent first
+// (ties alphabetical). The list owns copies of the words.
+inline WordFrequency* buildWordFrequencyList(const WordCounter& counts) {
+    std::vector<uint32_t> ids(counts.size());
+    size_t found = counts.topN(ids.size(), ids.data());
+
+    WordFrequency* head = nullptr;
+    WordFrequency** tail = &head;
+    for (size_t i = 0; i < found; i++) {
+        WordFrequency* node = new WordFrequency;
+        node->word.assign(counts.word(ids[i]), counts.wordLength(ids[i]));
+        node->frequency = (int)counts.frequency(ids[i]);
+        *tail = node;
+        tail = &node->next;
+    }
+    return head;
+}
+
+// Merge similar words in the list. The most frequent spelling of each
+// group of words within maxDistance edits keeps its node and absorbs the
+// frequencies of the others, which are deleted. Survivors keep their order.
+inline void mergeSimilarWords(WordFrequency*& wordFreq, int maxDistance = 2) {
+    std::vector<WordFrequency*> nodes;
+    for (WordFrequency* current = wordFreq; current; current = current->next) {
+        nodes.push_back(current);
+    }
+    if (nodes.size() < 2) return;
+
+    std::vector<const char*> words(nodes.size());
+    std::vector<size_t> lengths(nodes.size());
+    std::vector<uint64_t> weights(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        words[i] = nodes[i]->word.c_str();
+        lengths[i] = nodes[i]->word.size();
+        weights[i] = nodes[i]->frequency > 0 ? (uint64_t)nodes[i]->frequency : 0;
     }
-    
-    // Process any remaining word
-    if (!currentWord.empty()) {
-        MyString word(currentWord.c_str());
-        MyString normalizedWord = normalizeWord(word);
-        
-        if (std::string(normalizedWord.c_str()).length() > 1) {
-            // Update word frequency
-            WordFrequency* current = wordFreq;
-            bool found = false;
-            
-            while (current) {
-                if (current->word == normalizedWord) {
-                    current->frequency++;
-                    found = true;
-                    break;
-                }
-                current = current->next;
-            }
-            
-            if (!found) {
-                // Add new word to the list
-                WordFrequency* newWord = new WordFrequency;
-                newWord->word = normalizedWord;
-                newWord->frequency = 1;
-                newWord->next = wordFreq;
-                wordFreq = newWord;
-            }
+
+    std::vector<uint32_t> representative;
+    FuzzyMerger::group(words.data(), lengths.data(), weights.data(), nodes.size(),
+                       maxDistance, representative);
+
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (representative[i] != i) nodes[representative[i]]->frequency += nodes[i]->frequency;
+    }
+
+    // Relink the survivors and delete the merged nodes
+    WordFrequency** tail = &wordFreq;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (representative[i] == i) {
+            *tail = nodes[i];
+            tail = &nodes[i]->next;
+        } else {
+            delete nodes[i];
         }
     }
+    *tail = nullptr;
 }
 
-// Merge similar words in the list
-inline void mergeSimilarWords(WordFrequency*& wordFreq) {
-    WordFrequency* current = wordFreq;
-    
-    while (current) {
-        WordFrequency* runner = current->next;
-        WordFrequency* prev = current;
-        
-        while (runner) {
-            if (areWordsSimilar(current->word, runner->word, 2)) {
-                // Merge similar words (keep the one with higher frequency)
-                if (current->frequency >= runner->frequency) {
-                    current->frequency += runner->frequency;
-                    // Remove runner from the list
-                    prev->next = runner->next;
-                    WordFrequency* temp = runner;
-                    runner = runner->next;
-                    delete temp;
-                } else {
-                    runner->frequency += current->frequency;
-                    // Keep runner's word as the base word
-                    // We'll need to update all references to current later
-                    // For now, just continue
-                    prev = runner;
-                    runner = runner->next;
-                }
-            } else {
-                prev = runner;
-                runner = runner->next;
-            }
+// Heap order for word lists: a ranks above b when it is more frequent,
+// or equally frequent and earlier alphabetically
+struct WordRanksAbove {
+    bool operator()(const WordFrequency* a, const WordFrequency* b) const {
+        if (a->frequency != b->frequency) return a->frequency > b->frequency;
+        return strcmp(a->word.c_str(), b->word.c_str()) < 0;
+    }
+};
+
+// Collects the limit highest-ranked nodes into out, best first
+// (limit 0 means all of them). Only limit candidates are kept in the heap.
+inline size_t selectTopWords(WordFrequency* wordFreq, size_t limit, std::vector<WordFrequency*>& out) {
+    WordRanksAbove rankAbove;
+    // With "less" meaning "ranks above", the weakest candidate is on top
+    DaryHeap<WordFrequency*, WordRanksAbove> heap(rankAbove);
+
+    for (WordFrequency* current = wordFreq; current; current = current->next) {
+        if (limit == 0 || heap.getSize() < limit) {
+            heap.insert(current);
+        } else if (rankAbove(current, heap.top())) {
+            heap.replaceTop(current);
         }
-        
-        current = current->next;
     }
+
+    out.resize(heap.getSize());
+    for (size_t i = out.size(); i > 0; i--) {
+        out[i - 1] = heap.extractMax();
+    }
+    return out.size();
 }
 
 // Display word frequencies in descending order
 inline void displayWordFrequencies(WordFrequency* wordFreq, int limit) {
-    // Convert linked list to vector for sorting
-    std::vector<std::pair<MyString, int>> words;
-    WordFrequency* current = wordFreq;
-    
-    while (current) {
-        words.push_back({current->word, current->frequency});
-        current = current->next;
-    }
-    
-    // Sort by frequency (descending)
-    // std::sort removed; use HeapSort or KeithJumpSearch instead(words.begin(), words.end(), 
-              [](const std::pair<MyString, int>& a, const std::pair<MyString, int>& b) {
-        return a.second > b.second;
-    });
-    
+    std::vector<WordFrequency*> words;
+    selectTopWords(wordFreq, limit > 0 ? (size_t)limit : 0, words);
+
     // Display results
     std::cout << "Word Frequencies:" << std::endl;
     std::cout << "---------------" << std::endl;
-    
-    int count = 0;
-    for (const auto& pair : words) {
-        std::cout << pair.first.c_str() << ": " << pair.second << std::endl;
-        count++;
-        if (limit > 0 && count >= limit) break;
+
+    for (size_t i = 0; i < words.size(); i++) {
+        std::cout << words[i]->word.c_str() << ": " << words[i]->frequency << std::endl;
     }
 }
 
-// Find words in one-star reviews
-inline void findOneStarReviewWords(Review* reviews, WordFrequency*& wordFreq) {
-    Review* current = reviews;
-    
-    while (current) {
-        if (current->rating == 1) {
-            // Process the review text
-            processText(current->reviewText.c_str(), wordFreq);
-        }
-        current = current->next;
+// Find words in reviews with the given rating. Counting goes through a
+// hash table; entries already in wordFreq are folded into the new counts.
+// With threads != 1 the reviews are counted in parallel shards (0 uses one
+// per hardware thread); the result is the same as the serial count.
+inline void findReviewWords(Review* reviews, int rating, WordFrequency*& wordFreq, unsigned threads = 1) {
+    WordCounter counts;
+
+    while (wordFreq) {
+        WordFrequency* temp = wordFreq;
+        counts.add(temp->word.c_str(), temp->word.size(), (uint32_t)temp->frequency);
+        wordFreq = wordFreq->next;
+        delete temp;
     }
-    
+
+    std::vector<const Review*> matching;
+    ParallelWordCount::collect(reviews, [rating](const Review& review) {
+        return review.rating == rating;
+    }, matching);
+
+    // Process the review text
+    ParallelWordCount::count(matching, counts, [](const Review* review, WordCounter& shardCounts) {
+        processText(review->reviewText.c_str(), review->reviewText.size(), shardCounts);
+    }, threads);
+
+    wordFreq = buildWordFrequencyList(counts);
+
     // Merge similar words to get more accurate frequencies
     mergeSimilarWords(wordFreq);
 }
 
-// Sort words by frequency
+// Same as findReviewWords, reading the review texts straight from a mapped
+// snapshot; the ratings are scanned as one byte column
+inline void findReviewWords(const ReviewSnapshot& reviews, int rating, WordFrequency*& wordFreq,
+                            unsigned threads = 1) {
+    WordCounter counts;
+
+    while (wordFreq) {
+        WordFrequency* temp = wordFreq;
+        counts.add(temp->word.c_str(), temp->word.size(), (uint32_t)temp->frequency);
+        wordFreq = wordFreq->next;
+        delete temp;
+    }
+
+    // Each text is a view into the mapping, with its stored length
+    std::vector<FieldView> matching;
+    for (size_t row = 0; row < reviews.size(); row++) {
+        if (reviews.rating(row) == rating) matching.push_back(reviews.text(row));
+    }
+
+    ParallelWordCount::count(matching, counts, [](const FieldView& text, WordCounter& shardCounts) {
+        processText(text.ptr, text.len, shardCounts);
+    }, threads);
+
+    wordFreq = buildWordFrequencyList(counts);
+    mergeSimilarWords(wordFreq);
+}
+
+// Find words in one-star reviews
+inline void findOneStarReviewWords(Review* reviews, WordFrequency*& wordFreq, unsigned threads = 1) {
+    findReviewWords(reviews, 1, wordFreq, threads);
+}
+
+inline void findOneStarReviewWords(const ReviewSnapshot& reviews, WordFrequency*& wordFreq, unsigned threads = 1) {
+    findReviewWords(reviews, 1, wordFreq, threads);
+}
+
+// Sort words by frequency (descending, ties alphabetical) with a heap
 inline void sortWordsByFrequency(WordFrequency*& wordFreq) {
     // If list is empty or has only one node, it's already sorted
     if (!wordFreq || !wordFreq->next) return;
-    
-    // Convert to vector for sorting
+
     std::vector<WordFrequency*> words;
-    WordFrequency* current = wordFreq;
-    
-    while (current) {
-        words.push_back(current);
-        current = current->next;
-    }
-    
-    // Sort by frequency (descending)
-    // std::sort removed; use HeapSort or KeithJumpSearch instead(words.begin(), words.end(), 
-              [](const WordFrequency* a, const WordFrequency* b) {
-        return a->frequency > b->frequency;
-    });
-    
+    selectTopWords(wordFreq, 0, words);
+
     // Rebuild the linked list
     wordFreq = words[0];
     for (size_t i = 0; i < words.size() - 1; i++) {
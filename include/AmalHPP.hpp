@@ -2,6 +2,8 @@
 #define AMAL_HPP
 
 #include <string>
+#include <cstdint>
+#include "nodePool.hpp"
 using namespace std;
 
 struct Transaction{
@@ -9,6 +11,7 @@ struct Transaction{
     string product;
     double price;
     string date;
+    uint32_t dateKey;   // date as yyyymmdd, parsed once at load time
     string category;
     string paymentMethod;
 };
@@ -19,16 +22,29 @@ struct TransactionNode{
     TransactionNode(Transaction t);
 };
 
+// Singly linked list with a tail pointer, so appends are O(1) and whole
+// chains can be appended or spliced without walking the list. Nodes come
+// from the store's NodePool: rows appended in order sit next to each other
+// in memory, and the destructor frees them chunk by chunk.
 class TransactionLinkedListStore{
     private:
+        NodePool<TransactionNode> nodes;
         TransactionNode* head;
+        TransactionNode* tail;
         int size;
-        int convertDateToInt(const string& dateStr);
         void sortedInsertByDate(TransactionNode*& sortedHead, TransactionNode* newNode);
 
     public:
         TransactionLinkedListStore();
+        TransactionLinkedListStore(const TransactionLinkedListStore&) = delete;
+        TransactionLinkedListStore& operator=(const TransactionLinkedListStore&) = delete;
         void insert(const Transaction& t);
+        // A node owned by this store but not yet linked, for appendChain
+        TransactionNode* createNode(const Transaction& t);
+        // Links a pre-built chain first..last of count nodes made by createNode
+        void appendChain(TransactionNode* first, TransactionNode* last, int count);
+        // Moves every node of other onto the end of this list; other is left empty
+        void splice(TransactionLinkedListStore& other);
         void insertionSortByDate();
         void displayTransactions(int limit = 10) const;
         TransactionNode* getHead() const;
@@ -51,12 +67,19 @@ struct ReviewNode{
 
 class ReviewLinkedListStore{
     private:
+        NodePool<ReviewNode> nodes;
         ReviewNode* head;
+        ReviewNode* tail;
         int size;
 
     public:
         ReviewLinkedListStore();
+        ReviewLinkedListStore(const ReviewLinkedListStore&) = delete;
+        ReviewLinkedListStore& operator=(const ReviewLinkedListStore&) = delete;
         void insert(const Review& r);
+        ReviewNode* createNode(const Review& r);
+        void appendChain(ReviewNode* first, ReviewNode* last, int count);
+        void splice(ReviewLinkedListStore& other);
         ReviewNode* getHead() const;
         int getSize() const;
         void displayReviews();
@@ -3,6 +3,7 @@
 
 #include <string>
 #include <chrono>
+#include <cstddef>
 
 // Forward declarations
 struct TransactionNode;
@@ -16,14 +17,24 @@ public:
     
     // Array Merge Sort
     static void mergeSortArray(TransactionArray& transactions);
+
+    // Multi-threaded Array Merge Sort, stable on the date key.
+    // threads == 0 uses every hardware thread; small inputs use mergeSortArray.
+    static void parallelMergeSortArray(TransactionArray& transactions, unsigned threads = 0);
     
     // Helper functions for Linked List
     static TransactionNode* merge(TransactionNode* left, TransactionNode* right);
     static void split(TransactionNode* source, TransactionNode*& left, TransactionNode*& right);
     
     // Helper functions for Array
-    static void mergeArrays(TransactionData* arr, size_t left, size_t mid, size_t right);
-    static void mergeSortArrayRecursive(TransactionData* arr, size_t left, size_t right);
+    static const size_t INSERTION_RUN = 16;   // Runs up to this length use insertion sort
+    static void insertionSortRange(TransactionData* arr, size_t begin, size_t end);
+    static void mergeRuns(TransactionData* src, size_t left, size_t mid, size_t right, TransactionData* dst);
+    static void mergeSpans(TransactionData* src, size_t a, size_t aEnd, size_t b, size_t bEnd,
+                           TransactionData* dst, size_t out);
+    static size_t mergeSplit(const TransactionData* src, size_t left, size_t mid, size_t right, size_t k);
+    static void sortRange(TransactionData* arr, TransactionData* scratch, size_t begin, size_t end);
+    static const size_t PARALLEL_THRESHOLD = 1 << 15;   // Below this the serial sort is faster
     
     // Performance measurement
     template<typename Func>
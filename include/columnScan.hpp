@@ -0,0 +1,184 @@
+#ifndef COLUMN_SCAN_HPP
+#define COLUMN_SCAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "cpuFeatures.hpp"
+
+// One "column == value" term of a conjunction over an 8-bit code column
+struct CodeEquals {
+    const uint8_t* codes;
+    uint8_t value;
+};
+
+// Filter-and-count kernels over dictionary-encoded (8-bit code) columns.
+// Conjunctions are evaluated 32 rows at a time: each term is one SIMD byte
+// compare whose result is packed into a 32-bit row mask, the masks are
+// ANDed, and matches are counted with popcount. AVX2 or SSE2 is picked at
+// run time, with a plain loop on other CPUs.
+class ColumnScan {
+public:
+    // Name of the kernel picked for this CPU: "avx2", "sse2" or "scalar"
+    static const char* activeIsa() { return kernels().name; }
+
+    // Rows in [0, n) where every term matches
+    static size_t countAll(const CodeEquals* terms, size_t termCount, size_t n) {
+        if (n == 0) return 0;
+        if (termCount == 0) return n;
+
+        size_t blocks = n / BLOCK;
+        size_t total = kernels().countAll(terms, termCount, blocks);
+
+        for (size_t row = blocks * BLOCK; row < n; row++) {
+            bool match = true;
+            for (size_t t = 0; t < termCount && match; t++) {
+                match = terms[t].codes[row] == terms[t].value;
+            }
+            total += match;
+        }
+        return total;
+    }
+
+    static size_t countEqual(const uint8_t* codes, size_t n, uint8_t value) {
+        CodeEquals term = {codes, value};
+        return countAll(&term, 1, n);
+    }
+
+    // Cross-tabulation of two code columns in one pass:
+    // counts[a * secondValues + b] = rows with first == a and second == b.
+    // Codes must be below firstValues / secondValues.
+    //
+    // With few cells a histogram on the combined code beats one masked
+    // popcount per cell. Consecutive rows often hit the same cell, so
+    // four interleaved copies of the table are used to keep successive
+    // increments independent; they are summed at the end.
+    static void crossTab(const uint8_t* first, size_t firstValues, const uint8_t* second, size_t secondValues,
+                         size_t n, size_t* counts) {
+        size_t cells = firstValues * secondValues;
+        memset(counts, 0, sizeof(size_t) * cells);
+        if (n == 0 || cells == 0) return;
+
+        const size_t LANES = 4;
+        size_t* lanes = new size_t[LANES * cells]();
+
+        size_t row = 0;
+        for (; row + LANES <= n; row += LANES) {
+            for (size_t lane = 0; lane < LANES; lane++) {
+                lanes[lane * cells + first[row + lane] * secondValues + second[row + lane]]++;
+            }
+        }
+        for (; row < n; row++) {
+            lanes[first[row] * secondValues + second[row]]++;
+        }
+
+        for (size_t lane = 0; lane < LANES; lane++) {
+            for (size_t cell = 0; cell < cells; cell++) counts[cell] += lanes[lane * cells + cell];
+        }
+        delete[] lanes;
+    }
+
+    // Sum of n doubles
+    static double sum(const double* values, size_t n) {
+        double total = 0.0;
+        for (size_t row = 0; row < n; row++) total += values[row];
+        return total;
+    }
+
+    // Rows with fromKey <= keys[row] <= toKey, and the sum of their values
+    static size_t countInRange(const uint32_t* keys, const double* values, size_t n,
+                               uint32_t fromKey, uint32_t toKey, double* valueTotal) {
+        size_t matches = 0;
+        double total = 0.0;
+        for (size_t row = 0; row < n; row++) {
+            // Branch-free: the compare result is added instead of tested
+            size_t in = (size_t)(keys[row] >= fromKey) & (size_t)(keys[row] <= toKey);
+            matches += in;
+            total += in ? values[row] : 0.0;
+        }
+        if (valueTotal) *valueTotal = total;
+        return matches;
+    }
+
+private:
+    static const size_t BLOCK = 32;
+
+    struct Kernels {
+        // Rows matching every term over whole blocks [0, blocks * BLOCK)
+        size_t (*countAll)(const CodeEquals* terms, size_t termCount, size_t blocks);
+        const char* name;
+    };
+
+    // ---- Scalar kernels ----
+
+    static size_t countAllScalar(const CodeEquals* terms, size_t termCount, size_t blocks) {
+        size_t total = 0;
+        for (size_t row = 0; row < blocks * BLOCK; row++) {
+            bool match = true;
+            for (size_t t = 0; t < termCount && match; t++) {
+                match = terms[t].codes[row] == terms[t].value;
+            }
+            total += match;
+        }
+        return total;
+    }
+
+#if defined(CPU_X86)
+    // ---- SSE2 kernels (two 16-byte halves per block) ----
+
+    CPU_TARGET_SSE2
+    static uint32_t equalMaskSse2(const uint8_t* codes, uint8_t value) {
+        __m128i needle = _mm_set1_epi8((char)value);
+        __m128i low = _mm_loadu_si128((const __m128i*)codes);
+        __m128i high = _mm_loadu_si128((const __m128i*)(codes + 16));
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(low, needle))
+             | ((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(high, needle)) << 16);
+    }
+
+    CPU_TARGET_SSE2
+    static size_t countAllSse2(const CodeEquals* terms, size_t termCount, size_t blocks) {
+        size_t total = 0;
+        for (size_t b = 0; b < blocks; b++) {
+            uint32_t mask = 0xFFFFFFFFu;
+            for (size_t t = 0; t < termCount && mask; t++) {
+                mask &= equalMaskSse2(terms[t].codes + b * BLOCK, terms[t].value);
+            }
+            total += popCount32(mask);
+        }
+        return total;
+    }
+
+    // ---- AVX2 kernels (one 32-byte register per block) ----
+
+    CPU_TARGET_AVX2
+    static size_t countAllAvx2(const CodeEquals* terms, size_t termCount, size_t blocks) {
+        size_t total = 0;
+        for (size_t b = 0; b < blocks; b++) {
+            uint32_t mask = 0xFFFFFFFFu;
+            for (size_t t = 0; t < termCount && mask; t++) {
+                __m256i v = _mm256_loadu_si256((const __m256i*)(terms[t].codes + b * BLOCK));
+                __m256i eq = _mm256_cmpeq_epi8(v, _mm256_set1_epi8((char)terms[t].value));
+                mask &= (uint32_t)_mm256_movemask_epi8(eq);
+            }
+            total += popCount32(mask);
+        }
+        return total;
+    }
+#endif
+
+    static Kernels pickKernels() {
+#if defined(CPU_X86)
+        if (cpuHasAvx2()) return Kernels{countAllAvx2, "avx2"};
+        if (cpuHasSse2()) return Kernels{countAllSse2, "sse2"};
+#endif
+        return Kernels{countAllScalar, "scalar"};
+    }
+
+    // Chosen once, on first use
+    static const Kernels& kernels() {
+        static const Kernels chosen = pickKernels();
+        return chosen;
+    }
+};
+
+#endif // COLUMN_SCAN_HPP
@@ -0,0 +1,79 @@
+#ifndef CPU_FEATURES_HPP
+#define CPU_FEATURES_HPP
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CPU_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit AVX2 code inside functions marked for it, which
+// lets one binary carry both paths and pick one at run time. Every AVX2
+// CPU also has POPCNT, so AVX2 functions may use it too.
+#if defined(CPU_X86) && defined(__GNUC__)
+#define CPU_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#define CPU_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define CPU_TARGET_AVX2
+#define CPU_TARGET_SSE2
+#endif
+
+// Run-time checks for the instruction sets the SIMD kernels use
+
+inline bool cpuHasAvx2() {
+#if defined(CPU_X86) && defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(CPU_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+inline bool cpuHasSse2() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return true;   // Part of the x86-64 baseline
+#elif defined(CPU_X86) && defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#elif defined(CPU_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    return false;
+#endif
+}
+
+inline unsigned lowestSetBit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+inline unsigned popCount32(uint32_t mask) {
+#if defined(__GNUC__)
+    return (unsigned)__builtin_popcount(mask);
+#else
+    mask = mask - ((mask >> 1) & 0x55555555u);
+    mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+    return (unsigned)((((mask + (mask >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+#endif
+}
+
+#endif // CPU_FEATURES_HPP
@@ -0,0 +1,441 @@
+#ifndef CSV_READER_HPP
+#define CSV_READER_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Non-owning view of a field (pointer + length) inside a larger buffer.
+// The view is only valid while the buffer it points into is alive.
+struct FieldView {
+    const char* ptr;
+    size_t len;
+
+    FieldView() : ptr(nullptr), len(0) {}
+    FieldView(const char* p, size_t n) : ptr(p), len(n) {}
+
+    bool empty() const { return len == 0; }
+
+    bool equals(const char* str) const {
+        size_t n = strlen(str);
+        return n == len && memcmp(ptr, str, n) == 0;
+    }
+
+    // Case-insensitive comparison, used for header names
+    bool equalsIgnoreCase(const char* str) const {
+        size_t n = strlen(str);
+        if (n != len) return false;
+        for (size_t i = 0; i < n; i++) {
+            if (tolower((unsigned char)ptr[i]) != tolower((unsigned char)str[i])) return false;
+        }
+        return true;
+    }
+
+    std::string toString() const { return std::string(ptr, len); }
+};
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+private:
+    const char* data;
+    size_t length;
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#endif
+
+public:
+    MappedFile() : data(nullptr), length(0) {
+#ifdef _WIN32
+        fileHandle = INVALID_HANDLE_VALUE;
+        mappingHandle = nullptr;
+#endif
+    }
+
+    ~MappedFile() {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& filename) {
+        close();
+#ifdef _WIN32
+        fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                 OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize)) {
+            close();
+            return false;
+        }
+        length = (size_t)fileSize.QuadPart;
+        if (length == 0) return true; // Empty files cannot be mapped
+
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mappingHandle) {
+            close();
+            return false;
+        }
+        data = (const char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (!data) {
+            close();
+            return false;
+        }
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        length = (size_t)st.st_size;
+        if (length == 0) {
+            ::close(fd);
+            return true; // Empty files cannot be mapped
+        }
+
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping keeps its own reference to the file
+        if (mapped == MAP_FAILED) {
+            length = 0;
+            return false;
+        }
+        madvise(mapped, length, MADV_SEQUENTIAL);
+        data = (const char*)mapped;
+#endif
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mappingHandle) CloseHandle(mappingHandle);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+        mappingHandle = nullptr;
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (data) munmap((void*)data, length);
+#endif
+        data = nullptr;
+        length = 0;
+    }
+
+    const char* begin() const { return data; }
+    const char* end() const { return data + length; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+};
+
+// Walks a buffer line by line. Handles both "\n" and "\r\n" endings and
+// a last line without a trailing newline.
+class LineCursor {
+private:
+    const char* current;
+    const char* last;
+
+public:
+    LineCursor(const char* begin, const char* end) : current(begin), last(end) {}
+
+    bool next(FieldView& line) {
+        if (current >= last) return false;
+
+        const char* start = current;
+        const char* newline = (const char*)memchr(current, '\n', last - current);
+        const char* stop = newline ? newline : last;
+        current = newline ? newline + 1 : last;
+
+        if (stop > start && stop[-1] == '\r') stop--;
+        line = FieldView(start, stop - start);
+        return true;
+    }
+
+    const char* position() const { return current; }
+};
+
+// Reads a file one fixed-size block at a time and hands out the block's
+// whole lines, so memory stays at one block however large the file is. The
+// partial line at the end of a block is carried into the next one; a single
+// line longer than the block grows the buffer to fit it. The lines are
+// writable and stay valid until the next call to nextBlock.
+class BlockLineReader {
+private:
+    FILE* file;
+    std::vector<char> buffer;
+    size_t filled;     // Bytes of buffer holding file data
+    size_t consumed;   // Bytes already handed out
+    bool atEnd;
+
+public:
+    explicit BlockLineReader(size_t blockSize = 1 << 20)
+        : file(nullptr), buffer(blockSize > 0 ? blockSize : 1), filled(0), consumed(0), atEnd(false) {}
+
+    ~BlockLineReader() {
+        close();
+    }
+
+    BlockLineReader(const BlockLineReader&) = delete;
+    BlockLineReader& operator=(const BlockLineReader&) = delete;
+
+    bool open(const std::string& filename) {
+        close();
+        file = fopen(filename.c_str(), "rb");
+        filled = consumed = 0;
+        atEnd = false;
+        return file != nullptr;
+    }
+
+    void close() {
+        if (file) fclose(file);
+        file = nullptr;
+    }
+
+    // Sets [begin, end) to the next run of whole lines (the last line of the
+    // file may lack its newline). Returns false when the file is exhausted.
+    bool nextBlock(char*& begin, char*& end) {
+        if (!file) return false;
+
+        size_t leftover = filled - consumed;
+        memmove(buffer.data(), buffer.data() + consumed, leftover);
+        filled = leftover;
+        consumed = 0;
+
+        while (true) {
+            if (!atEnd && filled < buffer.size()) {
+                size_t wanted = buffer.size() - filled;
+                size_t got = fread(buffer.data() + filled, 1, wanted, file);
+                filled += got;
+                atEnd = got < wanted;
+            }
+            if (filled == 0) return false;
+
+            size_t cut = filled;
+            while (cut > 0 && buffer[cut - 1] != '\n') cut--;
+
+            if (cut == 0 && !atEnd) {
+                // No newline in a full buffer: one line is longer than the block
+                buffer.resize(buffer.size() * 2);
+                continue;
+            }
+            if (cut == 0) cut = filled;   // Final line without a newline
+
+            begin = buffer.data();
+            end = buffer.data() + cut;
+            consumed = cut;
+            return true;
+        }
+    }
+};
+
+// Number of workers used when a parallel loader is called with workers == 0
+inline unsigned defaultWorkerCount() {
+    unsigned cores = std::thread::hardware_concurrency();
+    return cores == 0 ? 1 : cores;
+}
+
+// Splits [begin, end) into at most parts byte ranges whose boundaries fall
+// just after a newline, so no line is cut between two ranges.
+// bounds receives the range starts followed by end; returns the range count.
+inline size_t splitLineAlignedChunks(const char* begin, const char* end, size_t parts,
+                                     std::vector<const char*>& bounds) {
+    bounds.clear();
+    bounds.push_back(begin);
+    if (parts == 0) parts = 1;
+
+    size_t total = end - begin;
+    for (size_t i = 1; i < parts; i++) {
+        const char* target = begin + total / parts * i;
+        if (target <= bounds.back()) continue;
+
+        const char* newline = (const char*)memchr(target, '\n', end - target);
+        if (!newline || newline + 1 >= end) break;
+        bounds.push_back(newline + 1);
+    }
+    bounds.push_back(end);
+    return bounds.size() - 1;
+}
+
+// Runs work(chunkIndex, chunkBegin, chunkEnd) for every range produced by
+// splitLineAlignedChunks, one thread per range. Range 0 runs on the calling
+// thread. Callers index their per-range results by chunkIndex, which keeps
+// the results in file order.
+template <typename ChunkWork>
+inline void parallelForChunks(const std::vector<const char*>& bounds, ChunkWork work) {
+    size_t chunks = bounds.size() - 1;
+
+    std::vector<std::thread> threads;
+    threads.reserve(chunks > 0 ? chunks - 1 : 0);
+    for (size_t i = 1; i < chunks; i++) {
+        threads.emplace_back([&work, &bounds, i]() { work(i, bounds[i], bounds[i + 1]); });
+    }
+    if (chunks > 0) work(0, bounds[0], bounds[1]);
+
+    for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+}
+
+// Splits a line on the delimiter into at most maxFields views.
+// The last field keeps the rest of the line, delimiters included, so
+// free-text columns such as review text may contain commas.
+inline size_t splitFields(const FieldView& line, char delimiter, FieldView* out, size_t maxFields) {
+    if (maxFields == 0) return 0;
+
+    size_t count = 0;
+    const char* start = line.ptr;
+    const char* end = line.ptr + line.len;
+
+    while (count + 1 < maxFields) {
+        const char* sep = (const char*)memchr(start, delimiter, end - start);
+        if (!sep) break;
+        out[count++] = FieldView(start, sep - start);
+        start = sep + 1;
+    }
+    out[count++] = FieldView(start, end - start);
+    return count;
+}
+
+// Parses a decimal number from a field without allocating.
+// Uses a stack copy so strtod never reads past the end of the field.
+// The number must use up the field, bar trailing whitespace, so "12.5abc"
+// or "12,5" is rejected rather than read as 12.5 or 12.
+inline bool parseDouble(const FieldView& field, double& value) {
+    char buffer[64];
+    if (field.len == 0 || field.len >= sizeof(buffer)) return false;
+
+    memcpy(buffer, field.ptr, field.len);
+    buffer[field.len] = '\0';
+
+    char* endPtr = nullptr;
+    value = strtod(buffer, &endPtr);
+    if (endPtr == buffer) return false;
+    while (endPtr < buffer + field.len && isspace((unsigned char)*endPtr)) endPtr++;
+    return endPtr == buffer + field.len;
+}
+
+inline bool parseInt(const FieldView& field, int& value) {
+    size_t i = 0;
+    bool negative = false;
+    if (i < field.len && (field.ptr[i] == '-' || field.ptr[i] == '+')) {
+        negative = field.ptr[i] == '-';
+        i++;
+    }
+    if (i == field.len || !isdigit((unsigned char)field.ptr[i])) return false;
+
+    int result = 0;
+    while (i < field.len && isdigit((unsigned char)field.ptr[i])) {
+        result = result * 10 + (field.ptr[i] - '0');
+        i++;
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
+// Logical transaction columns, independent of the order in the file
+enum TransactionField {
+    TX_CUSTOMER = 0,
+    TX_PRODUCT,
+    TX_CATEGORY,
+    TX_PRICE,
+    TX_DATE,
+    TX_PAYMENT,
+    TX_FIELD_COUNT
+};
+
+// Maps the physical columns of a transaction CSV to TransactionField.
+// Supports the raw "Customer ID,Product,Category,..." header and the cleaned
+// "Customer|Product,Category,..." header where the first column holds both ids.
+class TransactionLayout {
+private:
+    static const size_t MAX_COLUMNS = 16;
+
+    int column[TX_FIELD_COUNT];
+    int combinedColumn;   // Column holding "customer|product", or -1
+    size_t columnCount;
+
+public:
+    TransactionLayout() : combinedColumn(-1), columnCount(TX_FIELD_COUNT) {
+        // Positional order assumed when the header is not recognised
+        column[TX_CUSTOMER] = 0;
+        column[TX_PRODUCT] = 1;
+        column[TX_PRICE] = 2;
+        column[TX_DATE] = 3;
+        column[TX_CATEGORY] = 4;
+        column[TX_PAYMENT] = 5;
+    }
+
+    // Returns false (keeping the positional layout) if the header is unrecognised
+    bool fromHeader(const FieldView& header) {
+        FieldView names[MAX_COLUMNS];
+        size_t count = splitFields(header, ',', names, MAX_COLUMNS);
+
+        int found[TX_FIELD_COUNT];
+        for (int f = 0; f < TX_FIELD_COUNT; f++) found[f] = -1;
+        int combined = -1;
+
+        for (size_t i = 0; i < count; i++) {
+            const FieldView& name = names[i];
+            if (name.equalsIgnoreCase("Customer|Product")) combined = (int)i;
+            else if (name.equalsIgnoreCase("Customer ID") || name.equalsIgnoreCase("CustomerID") ||
+                     name.equalsIgnoreCase("Customer")) found[TX_CUSTOMER] = (int)i;
+            else if (name.equalsIgnoreCase("Product")) found[TX_PRODUCT] = (int)i;
+            else if (name.equalsIgnoreCase("Category")) found[TX_CATEGORY] = (int)i;
+            else if (name.equalsIgnoreCase("Price")) found[TX_PRICE] = (int)i;
+            else if (name.equalsIgnoreCase("Date")) found[TX_DATE] = (int)i;
+            else if (name.equalsIgnoreCase("Payment Method") ||
+                     name.equalsIgnoreCase("PaymentMethod")) found[TX_PAYMENT] = (int)i;
+        }
+
+        if (combined >= 0) {
+            found[TX_CUSTOMER] = combined;
+            found[TX_PRODUCT] = combined;
+        }
+        for (int f = 0; f < TX_FIELD_COUNT; f++) {
+            if (found[f] < 0) return false;
+        }
+
+        for (int f = 0; f < TX_FIELD_COUNT; f++) column[f] = found[f];
+        combinedColumn = combined;
+        columnCount = count;
+        return true;
+    }
+
+    // Fills out[TX_FIELD_COUNT] with views into the line; false if fields are missing
+    bool split(const FieldView& line, FieldView* out) const {
+        FieldView fields[MAX_COLUMNS];
+        size_t count = splitFields(line, ',', fields, columnCount);
+        if (count < columnCount) return false;
+
+        for (int f = 0; f < TX_FIELD_COUNT; f++) out[f] = fields[column[f]];
+
+        if (combinedColumn >= 0) {
+            const FieldView& both = fields[combinedColumn];
+            const char* pipe = (const char*)memchr(both.ptr, '|', both.len);
+            if (!pipe) return false;
+            out[TX_CUSTOMER] = FieldView(both.ptr, pipe - both.ptr);
+            out[TX_PRODUCT] = FieldView(pipe + 1, both.ptr + both.len - (pipe + 1));
+        }
+        return true;
+    }
+};
+
+#endif // CSV_READER_HPP
@@ -0,0 +1,115 @@
+#ifndef DARY_HEAP_HPP
+#define DARY_HEAP_HPP
+
+#include <cstddef>
+#include <stdexcept>
+
+// Default ordering for DaryHeap: the largest element is on top
+template <typename T>
+struct HeapLess {
+    bool operator()(const T& a, const T& b) const { return a < b; }
+};
+
+// Implicit d-ary max-heap kept in one contiguous array. The children of
+// slot i are slots Arity*i+1 .. Arity*i+Arity, so there are no node
+// pointers to chase and no per-element allocation. A wider node means a
+// shallower tree and more siblings per cache line than a binary heap.
+template <typename T, typename Less = HeapLess<T>, size_t Arity = 4>
+class DaryHeap {
+private:
+    T* items;
+    size_t count;
+    size_t capacity;
+    Less less;
+
+    void grow() {
+        reallocate(capacity == 0 ? 16 : capacity * 2);
+    }
+
+    void reallocate(size_t newCapacity) {
+        T* newItems = new T[newCapacity];
+        for (size_t i = 0; i < count; i++) newItems[i] = items[i];
+        delete[] items;
+        items = newItems;
+        capacity = newCapacity;
+    }
+
+    void heapifyUp(size_t index) {
+        T value = items[index];
+        while (index > 0) {
+            size_t parent = (index - 1) / Arity;
+            if (!less(items[parent], value)) break;
+            items[index] = items[parent];
+            index = parent;
+        }
+        items[index] = value;
+    }
+
+    void heapifyDown(size_t index) {
+        T value = items[index];
+        while (true) {
+            size_t first = index * Arity + 1;
+            if (first >= count) break;
+            size_t last = first + Arity < count ? first + Arity : count;
+
+            size_t largest = first;
+            for (size_t child = first + 1; child < last; child++) {
+                if (less(items[largest], items[child])) largest = child;
+            }
+            if (!less(value, items[largest])) break;
+
+            items[index] = items[largest];
+            index = largest;
+        }
+        items[index] = value;
+    }
+
+public:
+    DaryHeap() : items(nullptr), count(0), capacity(0) {}
+
+    explicit DaryHeap(const Less& order) : items(nullptr), count(0), capacity(0), less(order) {}
+
+    ~DaryHeap() {
+        delete[] items;
+    }
+
+    DaryHeap(const DaryHeap&) = delete;
+    DaryHeap& operator=(const DaryHeap&) = delete;
+
+    // Allocates room for newCapacity items in one step
+    void reserve(size_t newCapacity) {
+        if (capacity < newCapacity) reallocate(newCapacity);
+    }
+
+    void insert(const T& value) {
+        if (count == capacity) grow();
+        items[count] = value;
+        heapifyUp(count++);
+    }
+
+    const T& top() const {
+        if (count == 0) throw std::runtime_error("Heap is empty");
+        return items[0];
+    }
+
+    T extractMax() {
+        if (count == 0) throw std::runtime_error("Heap is empty");
+        T maxVal = items[0];
+        items[0] = items[--count];
+        if (count > 0) heapifyDown(0);
+        return maxVal;
+    }
+
+    // Replaces the top element and restores the heap in one sift-down
+    void replaceTop(const T& value) {
+        if (count == 0) throw std::runtime_error("Heap is empty");
+        items[0] = value;
+        heapifyDown(0);
+    }
+
+    void clear() { count = 0; }
+    size_t getSize() const { return count; }
+    bool isEmpty() const { return count == 0; }
+};
+
+#endif // DARY_HEAP_HPP
@@ -0,0 +1,42 @@
+#ifndef DATE_KEY_HPP
+#define DATE_KEY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Transaction dates are stored as "DD/MM/YYYY" text, which does not sort
+// correctly as a string. A date key packs the same date as the integer
+// yyyymmdd, so comparing two keys compares the dates chronologically.
+// Keys are parsed once at load time and stored next to the text.
+
+// Returns the yyyymmdd key of a "DD/MM/YYYY" date, or 0 if the text is not
+// in that format or the day/month are out of range.
+inline uint32_t parseDateKey(const char* text, size_t len) {
+    if (len != 10 || text[2] != '/' || text[5] != '/') return 0;
+
+    static const int digitPositions[8] = {0, 1, 3, 4, 6, 7, 8, 9};
+    int digits[8];
+    for (int i = 0; i < 8; i++) {
+        char c = text[digitPositions[i]];
+        if (c < '0' || c > '9') return 0;
+        digits[i] = c - '0';
+    }
+
+    uint32_t day = digits[0] * 10 + digits[1];
+    uint32_t month = digits[2] * 10 + digits[3];
+    uint32_t year = digits[4] * 1000 + digits[5] * 100 + digits[6] * 10 + digits[7];
+    if (day < 1 || day > 31 || month < 1 || month > 12) return 0;
+
+    return year * 10000 + month * 100 + day;
+}
+
+inline uint32_t dateKeyYear(uint32_t key) { return key / 10000; }
+inline uint32_t dateKeyMonth(uint32_t key) { return key / 100 % 100; }
+inline uint32_t dateKeyDay(uint32_t key) { return key % 100; }
+
+// Builds a key from its parts, e.g. for range bounds in queries
+inline uint32_t makeDateKey(uint32_t year, uint32_t month, uint32_t day) {
+    return year * 10000 + month * 100 + day;
+}
+
+#endif // DATE_KEY_HPP
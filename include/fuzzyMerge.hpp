@@ -0,0 +1,210 @@
+#ifndef FUZZY_MERGE_HPP
+#define FUZZY_MERGE_HPP
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "daryHeap.hpp"
+#include "stringInterner.hpp"
+
+// Levenshtein (insert / delete / substitute) distance between two byte
+// strings. When the distance is above maxDistance the computation stops
+// early and maxDistance + 1 is returned.
+inline int levenshteinDistance(const char* a, size_t aLen, const char* b, size_t bLen,
+                               int maxDistance = INT_MAX) {
+    if (aLen < bLen) {
+        const char* t = a; a = b; b = t;
+        size_t l = aLen; aLen = bLen; bLen = l;
+    }
+    // b is now the shorter string; the length gap alone is a lower bound
+    if (aLen - bLen > (size_t)maxDistance) return maxDistance + 1;
+    if (bLen == 0) return (int)aLen;
+
+    // Two rows over b; short words stay on the stack
+    int stackRows[2 * 65];
+    std::vector<int> heapRows;
+    int* prev = stackRows;
+    if (bLen + 1 > 65) {
+        heapRows.resize(2 * (bLen + 1));
+        prev = heapRows.data();
+    }
+    int* curr = prev + bLen + 1;
+
+    for (size_t j = 0; j <= bLen; j++) prev[j] = (int)j;
+
+    for (size_t i = 1; i <= aLen; i++) {
+        curr[0] = (int)i;
+        int rowMin = curr[0];
+        for (size_t j = 1; j <= bLen; j++) {
+            int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            int best = prev[j - 1] + cost;
+            if (prev[j] + 1 < best) best = prev[j] + 1;
+            if (curr[j - 1] + 1 < best) best = curr[j - 1] + 1;
+            curr[j] = best;
+            if (best < rowMin) rowMin = best;
+        }
+        // Every later cell is at least the row minimum
+        if (rowMin > maxDistance) return maxDistance + 1;
+        int* t = prev; prev = curr; curr = t;
+    }
+
+    return prev[bLen] > maxDistance ? maxDistance + 1 : prev[bLen];
+}
+
+// Symmetric deletion index (as in SymSpell). Every word is stored under
+// all strings obtained by deleting up to maxDeletes of its characters. Two
+// words within Levenshtein distance k share at least one such string when
+// both are expanded to k deletions, so looking up the query's own deletion
+// variants yields every candidate, which is then checked with a bounded
+// Levenshtein. Lookups are hash probes; the vocabulary is never scanned.
+class DeletionIndex {
+private:
+    static const uint32_t NONE = 0xFFFFFFFFu;
+
+    const char* const* words;
+    const size_t* lengths;
+    int maxDeletes;
+
+    StringInterner variants;             // Deletion variant -> variant id
+    std::vector<uint32_t> firstPosting;  // Per variant id
+    std::vector<uint32_t> postingWord;
+    std::vector<uint32_t> postingNext;
+
+    // Words seen by the current query, stamped with the query number
+    mutable std::vector<uint32_t> seenBy;
+    mutable uint32_t queryStamp;
+
+    // Calls onVariant(ptr, len) for the word itself and every string made
+    // by deleting 1 .. maxDeletes characters. Deleting positions in
+    // increasing order avoids most repeats; the rest are filtered by callers.
+    template <typename OnVariant>
+    static void forEachVariant(const char* word, size_t len, int deletes, OnVariant onVariant) {
+        std::vector<char> buffers((size_t)(deletes + 1) * (len + 1));
+        memcpy(buffers.data(), word, len);
+        onVariant(buffers.data(), len);
+        expand(buffers.data(), len, 0, deletes, len + 1, onVariant);
+    }
+
+    template <typename OnVariant>
+    static void expand(char* current, size_t len, size_t from, int deletesLeft, size_t stride,
+                       OnVariant& onVariant) {
+        if (deletesLeft == 0 || len == 0) return;
+        char* next = current + stride;
+        for (size_t i = from; i < len; i++) {
+            // Deleting any char of a run gives the same string; take the first
+            if (i > from && current[i] == current[i - 1]) continue;
+            memcpy(next, current, i);
+            memcpy(next + i, current + i + 1, len - i - 1);
+            onVariant(next, len - 1);
+            expand(next, len - 1, i, deletesLeft - 1, stride, onVariant);
+        }
+    }
+
+public:
+    DeletionIndex(const char* const* wordList, const size_t* wordLengths, int maxDistance)
+        : words(wordList), lengths(wordLengths), maxDeletes(maxDistance), queryStamp(0) {}
+
+    DeletionIndex(const DeletionIndex&) = delete;
+    DeletionIndex& operator=(const DeletionIndex&) = delete;
+
+    void insert(uint32_t item) {
+        if (item >= seenBy.size()) seenBy.resize(item + 1, uint32_t(NONE));
+
+        forEachVariant(words[item], lengths[item], maxDeletes, [&](const char* variant, size_t len) {
+            uint32_t id = variants.intern(variant, len);
+            if (id == firstPosting.size()) firstPosting.push_back(uint32_t(NONE));
+
+            // Repeated variants of one word arrive back to back
+            uint32_t head = firstPosting[id];
+            if (head != NONE && postingWord[head] == item) return;
+
+            postingWord.push_back(item);
+            postingNext.push_back(head);
+            firstPosting[id] = (uint32_t)(postingWord.size() - 1);
+        });
+    }
+
+    // Calls onMatch(item, distance) once for every indexed word within
+    // radius <= maxDistance of word
+    template <typename OnMatch>
+    void findWithin(const char* word, size_t len, int radius, OnMatch onMatch) const {
+        if (++queryStamp == NONE) {
+            seenBy.assign(seenBy.size(), uint32_t(NONE));
+            queryStamp = 0;
+        }
+
+        forEachVariant(word, len, maxDeletes, [&](const char* variant, size_t variantLen) {
+            uint32_t id;
+            if (!variants.find(variant, variantLen, id)) return;
+
+            for (uint32_t p = firstPosting[id]; p != NONE; p = postingNext[p]) {
+                uint32_t item = postingWord[p];
+                if (seenBy[item] == queryStamp) continue;
+                seenBy[item] = queryStamp;
+
+                int d = levenshteinDistance(words[item], lengths[item], word, len, radius);
+                if (d <= radius) onMatch(item, d);
+            }
+        });
+    }
+};
+
+// Groups near-duplicate words (typos, plurals, ...) under one spelling.
+// Words are visited from the highest weight down (ties alphabetical); each
+// word not yet taken becomes a representative and takes every untaken word
+// within maxDistance of it. Matches come from a DeletionIndex, so the work
+// grows with the size of each neighbourhood rather than with the square of
+// the vocabulary.
+class FuzzyMerger {
+private:
+    struct Ranked {
+        const char* const* words;
+        const size_t* lengths;
+        const uint64_t* weights;
+
+        // "Less" for a max-heap: a comes out after b
+        bool operator()(uint32_t a, uint32_t b) const {
+            if (weights[a] != weights[b]) return weights[a] < weights[b];
+            size_t common = lengths[a] < lengths[b] ? lengths[a] : lengths[b];
+            int order = memcmp(words[a], words[b], common);
+            if (order != 0) return order > 0;
+            return lengths[a] > lengths[b];
+        }
+    };
+
+public:
+    // Fills representative[i] with the index of the word that word i is
+    // merged into (itself for representatives)
+    static void group(const char* const* words, const size_t* lengths, const uint64_t* weights,
+                      size_t count, int maxDistance, std::vector<uint32_t>& representative) {
+        const uint32_t UNASSIGNED = 0xFFFFFFFFu;
+        representative.assign(count, UNASSIGNED);
+        if (count == 0) return;
+
+        // Rank order by weight, pulled from a heap
+        Ranked ranked = {words, lengths, weights};
+        DaryHeap<uint32_t, Ranked> heap(ranked);
+        heap.reserve(count);
+        for (uint32_t i = 0; i < count; i++) heap.insert(i);
+
+        std::vector<uint32_t> order(count);
+        for (size_t i = 0; i < count; i++) order[i] = heap.extractMax();
+
+        DeletionIndex index(words, lengths, maxDistance);
+        for (uint32_t i = 0; i < count; i++) index.insert(i);
+
+        for (size_t i = 0; i < count; i++) {
+            uint32_t item = order[i];
+            if (representative[item] != UNASSIGNED) continue;
+            representative[item] = item;
+
+            index.findWithin(words[item], lengths[item], maxDistance, [&](uint32_t match, int) {
+                if (representative[match] == UNASSIGNED) representative[match] = item;
+            });
+        }
+    }
+};
+
+#endif // FUZZY_MERGE_HPP
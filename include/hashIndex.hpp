@@ -0,0 +1,130 @@
+#ifndef HASH_INDEX_HPP
+#define HASH_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "stringInterner.hpp"
+#include "csvReader.hpp"
+
+// Rows sharing one key, in the order they were added. A view into its
+// HashIndex: adding rows may move the storage, so look the key up again
+// after adding.
+class PostingList {
+private:
+    const uint32_t* nextRow;
+    uint32_t first;
+    uint32_t count;
+
+public:
+    // An enumerator, so that passing it by reference needs no definition
+    enum : uint32_t { NO_ROW = 0xFFFFFFFFu };
+
+    class iterator {
+    private:
+        const uint32_t* nextRow;
+        uint32_t row;
+
+    public:
+        iterator(const uint32_t* next, uint32_t r) : nextRow(next), row(r) {}
+
+        uint32_t operator*() const { return row; }
+        iterator& operator++() {
+            row = nextRow[row];
+            return *this;
+        }
+        bool operator==(const iterator& other) const { return row == other.row; }
+        bool operator!=(const iterator& other) const { return row != other.row; }
+    };
+
+    PostingList() : nextRow(nullptr), first(NO_ROW), count(0) {}
+    PostingList(const uint32_t* next, uint32_t head, uint32_t n) : nextRow(next), first(head), count(n) {}
+
+    iterator begin() const { return iterator(nextRow, first); }
+    iterator end() const { return iterator(nextRow, NO_ROW); }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+// Hash index from a string key (a customer or product ID) to the rows that
+// hold it. Keys map to dense ids through a StringInterner; each key id
+// keeps the first and last row of its list and every row keeps the next
+// row with the same key, so the postings cost 4 bytes per row plus 12 per
+// key, with no per-list allocation.
+//
+// Rows are numbered 0, 1, 2, ... in the order add() is called, so feeding
+// the rows of a store in order makes the numbers its row indexes. Adding a
+// row is O(1) (a lookup plus a tail link), so the index can be built in
+// the same pass as the load and kept current by adding each appended row.
+class HashIndex {
+private:
+    StringInterner keys;
+    std::vector<uint32_t> heads;     // Per key id: first row
+    std::vector<uint32_t> tails;     // Per key id: last row
+    std::vector<uint32_t> counts;    // Per key id: rows in the list
+    std::vector<uint32_t> nextRow;   // Per row: next row with the same key, or PostingList::NO_ROW
+
+public:
+    HashIndex() {}
+
+    HashIndex(const HashIndex&) = delete;
+    HashIndex& operator=(const HashIndex&) = delete;
+
+    // Indexes the next row under key and returns its number
+    uint32_t add(const char* key, size_t len) {
+        uint32_t row = (uint32_t)nextRow.size();
+        uint32_t id = keys.intern(key, len);
+        nextRow.push_back(PostingList::NO_ROW);
+
+        if (id == heads.size()) {
+            heads.push_back(row);
+            tails.push_back(row);
+            counts.push_back(1);
+        } else {
+            nextRow[tails[id]] = row;
+            tails[id] = row;
+            counts[id]++;
+        }
+        return row;
+    }
+
+    uint32_t add(const FieldView& key) { return add(key.ptr, key.len); }
+    uint32_t add(const char* key) { return add(key, strlen(key)); }
+
+    void reserve(size_t rows) { nextRow.reserve(rows); }
+
+    // Rows holding key; empty if there are none
+    PostingList find(const char* key, size_t len) const {
+        uint32_t id;
+        if (!keys.find(key, len, id)) return PostingList();
+        return PostingList(nextRow.data(), heads[id], counts[id]);
+    }
+
+    PostingList find(const FieldView& key) const { return find(key.ptr, key.len); }
+    PostingList find(const char* key) const { return find(key, strlen(key)); }
+
+    // Number of rows holding key
+    size_t count(const char* key, size_t len) const {
+        uint32_t id;
+        return keys.find(key, len, id) ? counts[id] : 0;
+    }
+
+    // Distinct keys, and the key with each id (ids in first-seen order)
+    size_t keyCount() const { return keys.size(); }
+    const char* key(uint32_t id) const { return keys.key(id); }
+    PostingList rowsOf(uint32_t id) const { return PostingList(nextRow.data(), heads[id], counts[id]); }
+
+    // Rows indexed so far; the next add() gets this number
+    size_t rowCount() const { return nextRow.size(); }
+
+    void clear() {
+        keys.clear();
+        heads.clear();
+        tails.clear();
+        counts.clear();
+        nextRow.clear();
+    }
+};
+
+#endif // HASH_INDEX_HPP
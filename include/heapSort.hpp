@@ -2,6 +2,7 @@
 #define HEAPSORT_HPP
 
 #include "linkedList.hpp"
+#include "daryHeap.hpp"
 #include <string>
 #include <iostream>
 #include <stdexcept>
@@ -9,45 +10,17 @@
 // Forward declarations
 struct TransactionNode;
 
-// Heap Node structure
-struct HeapNode {
-    double data;
-    HeapNode* parent;
-    HeapNode* left;
-    HeapNode* right;
-    HeapNode* next;
-
-    HeapNode(double val) : data(val), parent(nullptr), left(nullptr), right(nullptr), next(nullptr) {}
-};
-
-// Heap Linked List class
-class HeapLinkedList {
-private:
-    HeapNode* root;
-    HeapNode* last;
-    int size;
-
-    void heapifyUp(HeapNode* node);
-    void heapifyDown(HeapNode* node);
-    void swapValues(HeapNode* a, HeapNode* b);
-    HeapNode* getParent(HeapNode* node);
-    HeapNode* getLastParent();
-
-public:
-    HeapLinkedList();
-    ~HeapLinkedList();
-    
-    void insert(double value);
-    double extractMax();
-    HeapNode* getRoot() const;
-    int getSize() const;
-    bool isEmpty() const;
-};
-
 // Heap Sort class
 class HeapSort {
 public:
     static void sortTransactions(TransactionNode*& head);
+
+    // Top-K most expensive transactions without sorting everything.
+    // Streams over the input keeping only k candidates in a heap; fills out
+    // with the winners by descending price (earlier rows first on ties) and
+    // returns how many were written (less than k if there are fewer rows).
+    static size_t topKByPrice(const TransactionArray& transactions, size_t k, size_t* outRows);
+    static size_t topKByPrice(TransactionNode* head, size_t k, TransactionNode** outNodes);
     static void processTransactions(const std::string& filename);
 };
 
@@ -4,49 +4,121 @@
 #include <cstring>
 #include <iostream>
 #include <stdexcept>
-
-// Custom string implementation to avoid using STL containers
+#include <new>
+#include <utility>
+#include "stringArena.hpp"
+#include "dateKey.hpp"
+
+// Custom string implementation to avoid using STL containers.
+// A MyString either owns a heap copy of its characters or is a handle into
+// storage it does not own (a StringArena, or the shared empty string).
+// Copying a handle only copies the pointer, so it must not outlive its arena.
 class MyString {
 private:
     char* data;
     size_t length;
+    bool owned;
+
+    static char* emptyString() {
+        static char empty[1] = {'\0'};
+        return empty;
+    }
+
+    void copyOwned(const char* str, size_t len) {
+        data = new char[len + 1];
+        memcpy(data, str, len);
+        data[len] = '\0';
+        length = len;
+        owned = true;
+    }
+
+    void release() {
+        if (owned) delete[] data;
+        data = emptyString();
+        length = 0;
+        owned = false;
+    }
 
 public:
-    MyString() : data(nullptr), length(0) {
-        data = new char[1];
-        data[0] = '\0';
+    MyString() : data(emptyString()), length(0), owned(false) {}
+
+    MyString(const char* str) : data(emptyString()), length(0), owned(false) {
+        if (str && *str) {
+            copyOwned(str, strlen(str));
+        }
     }
 
-    MyString(const char* str) : data(nullptr), length(0) {
-        if (str) {
-            length = strlen(str);
-            data = new char[length + 1];
-            strcpy(data, str);
-        } else {
-            data = new char[1];
-            data[0] = '\0';
+    // Copies len bytes from a buffer that need not be null-terminated
+    MyString(const char* str, size_t len) : data(emptyString()), length(0), owned(false) {
+        if (len > 0) {
+            copyOwned(str, len);
         }
     }
 
-    MyString(const MyString& other) : data(nullptr), length(other.length) {
-        data = new char[length + 1];
-        strcpy(data, other.data);
+    // Stores len bytes in the arena; the string is a handle into it
+    MyString(const char* str, size_t len, StringArena& arena)
+        : data(arena.store(str, len)), length(len), owned(false) {}
+
+    MyString(const MyString& other) : data(other.data), length(other.length), owned(false) {
+        if (other.owned) {
+            copyOwned(other.data, other.length);
+        }
+    }
+
+    // Moving steals the buffer and leaves other empty; never allocates
+    MyString(MyString&& other) noexcept : data(other.data), length(other.length), owned(other.owned) {
+        other.data = emptyString();
+        other.length = 0;
+        other.owned = false;
     }
 
     ~MyString() {
-        delete[] data;
+        release();
     }
 
     MyString& operator=(const MyString& other) {
         if (this != &other) {
-            delete[] data;
+            release();
+            if (other.owned) {
+                copyOwned(other.data, other.length);
+            } else {
+                data = other.data;
+                length = other.length;
+            }
+        }
+        return *this;
+    }
+
+    MyString& operator=(MyString&& other) noexcept {
+        if (this != &other) {
+            release();
+            data = other.data;
             length = other.length;
-            data = new char[length + 1];
-            strcpy(data, other.data);
+            owned = other.owned;
+            other.data = emptyString();
+            other.length = 0;
+            other.owned = false;
         }
         return *this;
     }
 
+    // Replaces the contents with len bytes from a field view
+    void assign(const char* str, size_t len) {
+        release();
+        if (len > 0) {
+            copyOwned(str, len);
+        }
+    }
+
+    // Replaces the contents with a copy of len bytes stored in the arena
+    void assign(const char* str, size_t len, StringArena& arena) {
+        release();
+        data = arena.store(str, len);
+        length = len;
+    }
+
+    bool isArenaBacked() const { return !owned && length > 0; }
+
     bool operator<=(const MyString& other) const {
         return strcmp(data, other.data) <= 0;
     }
@@ -90,10 +162,11 @@ struct TransactionNode {
     MyString category;
     double price;
     MyString date;
+    uint32_t dateKey;   // date as yyyymmdd, used for ordering
     MyString paymentMethod;
     TransactionNode* next;
 
-    TransactionNode() : price(0.0), next(nullptr) {}
+    TransactionNode() : price(0.0), dateKey(0), next(nullptr) {}
 };
 
 // Array implementation (no next pointer)
@@ -103,45 +176,126 @@ struct TransactionData {
     MyString category;
     double price;
     MyString date;
+    uint32_t dateKey;   // date as yyyymmdd, used for ordering
     MyString paymentMethod;
 
-    TransactionData() : price(0.0) {}
+    TransactionData() : price(0.0), dateKey(0) {}
 };
 
-// Custom Dynamic Array Implementation for TransactionData
+// Custom Dynamic Array Implementation for TransactionData.
+// Storage is raw memory: only the first arraySize slots hold constructed
+// elements, and growth move-constructs them into the new block instead of
+// default-constructing the whole capacity and copying.
 class TransactionArray {
 private:
     TransactionData* data;
     size_t arraySize;
     size_t arrayCapacity;
+    StringArena strings;   // Owns the characters of arena-backed fields
 
-    void resize(size_t newCapacity) {
-        if (newCapacity <= arrayCapacity) return;
+    static TransactionData* allocateStorage(size_t capacity) {
+        return static_cast<TransactionData*>(::operator new(capacity * sizeof(TransactionData)));
+    }
 
-        TransactionData* newData = new TransactionData[newCapacity];
+    // Moves the live elements into newData and releases the old block
+    void relocate(TransactionData* newData, size_t newCapacity) {
         for (size_t i = 0; i < arraySize; ++i) {
-            newData[i] = data[i];
+            new (&newData[i]) TransactionData(std::move(data[i]));
+            data[i].~TransactionData();
         }
 
-        delete[] data;
+        ::operator delete(data);
         data = newData;
         arrayCapacity = newCapacity;
     }
 
+    void resize(size_t newCapacity) {
+        if (newCapacity <= arrayCapacity) return;
+        relocate(allocateStorage(newCapacity), newCapacity);
+    }
+
+    size_t grownCapacity() const {
+        return arrayCapacity == 0 ? 10 : arrayCapacity * 2;
+    }
+
+    void destroyElements() {
+        for (size_t i = 0; i < arraySize; ++i) {
+            data[i].~TransactionData();
+        }
+        arraySize = 0;
+    }
+
 public:
     TransactionArray() : data(nullptr), arraySize(0), arrayCapacity(0) {
         resize(10);
     }
 
     ~TransactionArray() {
-        delete[] data;
+        destroyElements();
+        ::operator delete(data);
     }
 
-    void push_back(const TransactionData& transaction) {
+    // Rows may be handles into the arena, so copying the array is not allowed
+    TransactionArray(const TransactionArray&) = delete;
+    TransactionArray& operator=(const TransactionArray&) = delete;
+
+    TransactionArray(TransactionArray&& other) noexcept
+        : data(other.data), arraySize(other.arraySize), arrayCapacity(other.arrayCapacity),
+          strings(std::move(other.strings)) {
+        other.data = nullptr;
+        other.arraySize = 0;
+        other.arrayCapacity = 0;
+    }
+
+    TransactionArray& operator=(TransactionArray&& other) noexcept {
+        if (this != &other) {
+            destroyElements();
+            ::operator delete(data);
+            data = other.data;
+            arraySize = other.arraySize;
+            arrayCapacity = other.arrayCapacity;
+            strings = std::move(other.strings);
+            other.data = nullptr;
+            other.arraySize = 0;
+            other.arrayCapacity = 0;
+        }
+        return *this;
+    }
+
+    // Makes room for at least capacity elements without constructing any
+    void reserve(size_t capacity) {
+        resize(capacity);
+    }
+
+    // Constructs a new element in place and returns it
+    template <typename... Args>
+    TransactionData& emplace_back(Args&&... args) {
         if (arraySize == arrayCapacity) {
-            resize(arrayCapacity == 0 ? 10 : arrayCapacity * 2);
+            // Build the new element first: args may refer into the old block
+            size_t newCapacity = grownCapacity();
+            TransactionData* newData = allocateStorage(newCapacity);
+            new (&newData[arraySize]) TransactionData(std::forward<Args>(args)...);
+            relocate(newData, newCapacity);
+        } else {
+            new (&data[arraySize]) TransactionData(std::forward<Args>(args)...);
         }
-        data[arraySize++] = transaction;
+        return data[arraySize++];
+    }
+
+    void push_back(const TransactionData& transaction) {
+        emplace_back(transaction);
+    }
+
+    void push_back(TransactionData&& transaction) {
+        emplace_back(std::move(transaction));
+    }
+
+    void clear() {
+        destroyElements();
+    }
+
+    size_t capacity() const {
+        return arrayCapacity;
     }
 
     const TransactionData& at(size_t index) const {
@@ -176,6 +330,9 @@ public:
 
     TransactionData* getDataPtr() { return data; }
     const TransactionData* getDataPtr() const { return data; }
+
+    // Arena for the strings of loaded rows; freed together with the array
+    StringArena& getArena() { return strings; }
 };
 
 #endif // LINKEDLIST_HPP 
\ No newline at end of file
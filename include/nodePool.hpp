@@ -0,0 +1,181 @@
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Slab allocator for list nodes of one type. Nodes are carved out of large
+// chunks in allocation order, so nodes appended one after another sit next
+// to each other in memory and a list walk reads memory sequentially.
+// destroy() puts a single node on a free list for reuse; clear() tears
+// down every node and returns the chunks in one pass.
+// Not thread-safe: parallel loaders use one pool per worker and absorb()
+// them into the list's pool afterwards, like StringArena.
+template <typename T>
+class NodePool {
+private:
+    union Slot {
+        Slot* nextFree;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    struct Chunk {
+        Chunk* next;
+        size_t capacity;
+        size_t used;
+
+        Slot* slots() {
+            return reinterpret_cast<Slot*>(reinterpret_cast<char*>(this) + HEADER_SIZE);
+        }
+    };
+
+    // Chunk header rounded up so the slots after it are aligned
+    static const size_t HEADER_SIZE = (sizeof(Chunk) + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot);
+    static const size_t DEFAULT_CHUNK_NODES = 1024;
+
+    Chunk* head;        // Chunk currently being filled; older chunks follow
+    Chunk* oldest;      // Last chunk of the chain, so absorb() need not walk it
+    Slot* freeList;
+    Slot* freeTail;
+    size_t chunkNodes;
+    size_t liveCount;
+
+    Slot* allocateSlot() {
+        if (freeList) {
+            Slot* slot = freeList;
+            freeList = slot->nextFree;
+            if (!freeList) freeTail = nullptr;
+            return slot;
+        }
+        if (!head || head->used == head->capacity) {
+            Chunk* chunk = static_cast<Chunk*>(::operator new(HEADER_SIZE + chunkNodes * sizeof(Slot)));
+            chunk->next = head;
+            chunk->capacity = chunkNodes;
+            chunk->used = 0;
+            if (!head) oldest = chunk;
+            head = chunk;
+        }
+        return &head->slots()[head->used++];
+    }
+
+    void pushFree(Slot* slot) {
+        slot->nextFree = freeList;
+        if (!freeList) freeTail = slot;
+        freeList = slot;
+    }
+
+    void freeChunks() {
+        while (head) {
+            Chunk* next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+        oldest = nullptr;
+        freeList = freeTail = nullptr;
+        liveCount = 0;
+    }
+
+public:
+    explicit NodePool(size_t nodesPerChunk = DEFAULT_CHUNK_NODES)
+        : head(nullptr), oldest(nullptr), freeList(nullptr), freeTail(nullptr),
+          chunkNodes(nodesPerChunk > 0 ? nodesPerChunk : 1), liveCount(0) {}
+
+    ~NodePool() {
+        clear();
+    }
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    NodePool(NodePool&& other) noexcept
+        : head(other.head), oldest(other.oldest), freeList(other.freeList), freeTail(other.freeTail),
+          chunkNodes(other.chunkNodes), liveCount(other.liveCount) {
+        other.head = other.oldest = nullptr;
+        other.freeList = other.freeTail = nullptr;
+        other.liveCount = 0;
+    }
+
+    // Constructs a node in the pool
+    template <typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot = allocateSlot();
+        T* node;
+        try {
+            node = new (slot->storage) T(std::forward<Args>(args)...);
+        } catch (...) {
+            pushFree(slot);
+            throw;
+        }
+        liveCount++;
+        return node;
+    }
+
+    // Destroys one node and keeps its slot for the next create()
+    void destroy(T* node) {
+        if (!node) return;
+        node->~T();
+        pushFree(reinterpret_cast<Slot*>(node));
+        liveCount--;
+    }
+
+    // Takes ownership of every chunk of other in O(1); its nodes stay valid
+    void absorb(NodePool& other) {
+        if (&other == this || !other.head) return;
+
+        // Keep our current chunk in front so it keeps being filled
+        if (head) {
+            other.oldest->next = head->next;
+            if (!head->next) oldest = other.oldest;
+            head->next = other.head;
+        } else {
+            head = other.head;
+            oldest = other.oldest;
+        }
+
+        if (other.freeList) {
+            other.freeTail->nextFree = freeList;
+            if (!freeList) freeTail = other.freeTail;
+            freeList = other.freeList;
+        }
+
+        liveCount += other.liveCount;
+        other.head = other.oldest = nullptr;
+        other.freeList = other.freeTail = nullptr;
+        other.liveCount = 0;
+    }
+
+    // Destroys every live node and frees the chunks. Trivially destructible
+    // nodes cost nothing per node; otherwise each chunk is walked once,
+    // skipping the slots on the free list.
+    void clear() {
+        if (!std::is_trivially_destructible<T>::value) {
+            std::vector<Slot*> freed;
+            for (Slot* slot = freeList; slot; slot = slot->nextFree) freed.push_back(slot);
+            std::sort(freed.begin(), freed.end());
+
+            for (Chunk* chunk = head; chunk; chunk = chunk->next) {
+                Slot* slots = chunk->slots();
+                for (size_t i = 0; i < chunk->used; i++) {
+                    if (!freed.empty() && std::binary_search(freed.begin(), freed.end(), &slots[i])) continue;
+                    reinterpret_cast<T*>(slots[i].storage)->~T();
+                }
+            }
+        }
+        freeChunks();
+    }
+
+    // Frees the chunks without running any destructor: O(chunks). Only for
+    // nodes that own nothing themselves, e.g. whose strings live in a
+    // StringArena; anything a node owns would leak.
+    void release() {
+        freeChunks();
+    }
+
+    size_t size() const { return liveCount; }
+};
+
+#endif // NODE_POOL_HPP
@@ -0,0 +1,89 @@
+#ifndef PARALLEL_WORD_COUNT_HPP
+#define PARALLEL_WORD_COUNT_HPP
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include "wordCounter.hpp"
+
+// Map-reduce word counting. The items are cut into contiguous shards, each
+// shard is counted into its own WordCounter on its own thread, and the
+// tables are merged pairwise in parallel rounds (a tree reduction).
+//
+// Merging always folds the right-hand table into the left one, so words
+// enter the final table in the same first-seen order as a serial pass over
+// the items, and counts and top-N results are identical to the serial path.
+
+class ParallelWordCount {
+private:
+    // Shards smaller than this cost more in thread start-up than they save
+    static const size_t MIN_ITEMS_PER_SHARD = 64;
+
+    // Runs task(0) .. task(count - 1) on separate threads; task 0 on the caller
+    template <typename Task>
+    static void runTasks(size_t count, Task task) {
+        std::vector<std::thread> threads;
+        threads.reserve(count > 0 ? count - 1 : 0);
+        for (size_t i = 1; i < count; i++) {
+            threads.emplace_back([&task, i]() { task(i); });
+        }
+        if (count > 0) task(0);
+        for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+    }
+
+public:
+    // Calls countItem(items[i], counter) for every item and adds the
+    // combined counts to result. Items are small handles, e.g. node
+    // pointers from collect() or FieldViews of texts.
+    // threads == 0 uses one per hardware thread.
+    template <typename Item, typename CountItem>
+    static void count(const std::vector<Item>& items, WordCounter& result,
+                      CountItem countItem, unsigned threads = 0) {
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+
+        size_t n = items.size();
+        size_t shards = n / MIN_ITEMS_PER_SHARD;
+        if (shards > threads) shards = threads;
+        if (shards <= 1) {
+            for (size_t i = 0; i < n; i++) countItem(items[i], result);
+            return;
+        }
+
+        // Shard 0 counts straight into result; the others get local tables
+        std::vector<WordCounter> locals(shards - 1);
+        std::vector<WordCounter*> tables(shards);
+        tables[0] = &result;
+        for (size_t s = 1; s < shards; s++) tables[s] = &locals[s - 1];
+
+        // Map: one contiguous range of items per shard
+        size_t shardSize = (n + shards - 1) / shards;
+        runTasks(shards, [&](size_t shard) {
+            size_t begin = shard * shardSize < n ? shard * shardSize : n;
+            size_t end = begin + shardSize < n ? begin + shardSize : n;
+            for (size_t i = begin; i < end; i++) countItem(items[i], *tables[shard]);
+        });
+
+        // Reduce: in each round table i absorbs table i + step
+        for (size_t step = 1; step < shards; step *= 2) {
+            size_t pairs = (shards - step + 2 * step - 1) / (2 * step);
+            runTasks(pairs, [&](size_t pair) {
+                size_t left = pair * 2 * step;
+                tables[left]->merge(*tables[left + step]);
+                tables[left + step]->clear();
+            });
+        }
+    }
+
+    // Collects the nodes of a next-linked list that pass the filter, in
+    // list order, so they can be sharded by index
+    template <typename Node, typename Filter>
+    static void collect(const Node* head, Filter accept, std::vector<const Node*>& out) {
+        out.clear();
+        for (const Node* node = head; node; node = node->next) {
+            if (accept(*node)) out.push_back(node);
+        }
+    }
+};
+
+#endif // PARALLEL_WORD_COUNT_HPP
@@ -0,0 +1,51 @@
+#ifndef RADIXSORT_HPP
+#define RADIXSORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Forward declarations
+struct TransactionNode;
+struct TransactionData;
+class TransactionArray;
+
+// Integer sort keys that can be extracted from a transaction.
+// Composite keys pack the first column in the high 32 bits, so a single
+// sort orders by both columns.
+enum RadixKey {
+    RADIX_BY_DATE,              // dateKey (yyyymmdd)
+    RADIX_BY_PRICE,             // price in cents
+    RADIX_BY_DATE_THEN_PRICE,   // dateKey, ties broken by price
+    RADIX_BY_PRICE_THEN_DATE    // price, ties broken by dateKey
+};
+
+// LSD radix sort on extracted integer keys: linear time, stable, no
+// comparisons. Only the byte positions where the keys actually differ are
+// sorted, so 24-bit dates take three passes, not eight.
+class RadixSort {
+public:
+    // Price in whole cents, clamped to [0, UINT32_MAX]
+    static uint32_t priceToCents(double price);
+
+    static uint64_t extractKey(const TransactionData& transaction, RadixKey key);
+    static uint64_t extractKey(const TransactionNode& transaction, RadixKey key);
+
+    // Sorts the custom array by the key; rows are moved, never copied
+    static void sortArray(TransactionArray& transactions, RadixKey key);
+
+    // Sorts the linked list by the key by relinking nodes into 256 buckets per pass
+    static void sortList(TransactionNode*& head, RadixKey key);
+
+    // Sorts keys[0, n) and applies the same reordering to rows[0, n)
+    static void sortKeys(uint64_t* keys, size_t* rows, size_t n);
+
+private:
+    static const int RADIX_BITS = 8;
+    static const size_t BUCKETS = 1 << RADIX_BITS;
+    static const int KEY_BYTES = 8;
+
+    // Bytes in which not every key is equal; other passes are skipped
+    static uint64_t varyingBits(const uint64_t* keys, size_t n);
+};
+
+#endif // RADIXSORT_HPP
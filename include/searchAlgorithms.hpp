@@ -0,0 +1,323 @@
+#ifndef SEARCH_ALGORITHMS_HPP
+#define SEARCH_ALGORITHMS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Ways to find a position in a sorted array
+enum SearchMethod {
+    SEARCH_LINEAR,          // Scan; best for a handful of keys
+    SEARCH_BRANCHLESS,      // Binary search with a conditional move instead of a branch
+    SEARCH_EYTZINGER,       // Binary search over a breadth-first copy, prefetching ahead
+    SEARCH_INTERPOLATION,   // Guesses the position from the key value; near O(1) on uniform keys
+    SEARCH_EXPONENTIAL      // Gallops from a known start; cost grows with the distance only
+};
+
+// Searches over sorted arrays. Every search is a partition point: given a
+// predicate before(x) that is true for a prefix of the array and false
+// after it, it returns the length of that prefix. With before(x) = x < key
+// that is the lower bound (first element >= key), with before(x) =
+// !(key < x) the upper bound (first element > key); n means "none".
+class SearchAlgorithms {
+public:
+    static const size_t LINEAR_LIMIT = 16;
+
+    template <typename T, typename Before>
+    static size_t linearPartition(const T* a, size_t n, Before before) {
+        size_t i = 0;
+        while (i < n && before(a[i])) i++;
+        return i;
+    }
+
+    // Halves the range each step without a data-dependent branch: the
+    // compiler turns the select into a conditional move, so there is no
+    // misprediction to pay on random keys
+    template <typename T, typename Before>
+    static size_t branchlessPartition(const T* a, size_t n, Before before) {
+        if (n == 0) return 0;
+        const T* base = a;
+        while (n > 1) {
+            size_t half = n / 2;
+            base = before(base[half]) ? base + half : base;
+            n -= half;
+        }
+        return (size_t)(base - a) + (before(*base) ? 1 : 0);
+    }
+
+    // The answer is known to be at or after from. Probes from + 1, 3, 7,
+    // 15, ... until the predicate turns false, then binary searches the
+    // last gap: O(log d) for an answer d places away.
+    template <typename T, typename Before>
+    static size_t exponentialPartition(const T* a, size_t n, Before before, size_t from = 0) {
+        if (from >= n) return n;
+        if (!before(a[from])) return from;
+
+        size_t low = from + 1;   // a[low - 1] is before the answer
+        size_t step = 1;
+        while (low + step - 1 < n && before(a[low + step - 1])) {
+            low += step;
+            step *= 2;
+        }
+        size_t high = low + step - 1 < n ? low + step - 1 : n;
+        return low + branchlessPartition(a + low, high - low, before);
+    }
+
+    // Numeric keys only. Each probe lands where the key would sit if the
+    // keys in the remaining range were evenly spread, so evenly spread keys
+    // take O(log log n) probes. After 32 probes (the keys are not uniform
+    // after all) it finishes with a binary search, so the worst case stays
+    // O(log n).
+    template <typename T>
+    static size_t interpolationLowerBound(const T* a, size_t n, T key) {
+        return interpolationSearch(a, n, key, false);
+    }
+
+    template <typename T>
+    static size_t interpolationUpperBound(const T* a, size_t n, T key) {
+        return interpolationSearch(a, n, key, true);
+    }
+
+    template <typename T, typename Key, typename Less>
+    static size_t branchlessLowerBound(const T* a, size_t n, const Key& key, Less less) {
+        return branchlessPartition(a, n, [&](const T& x) { return less(x, key); });
+    }
+
+    template <typename T>
+    static size_t branchlessLowerBound(const T* a, size_t n, T key) {
+        return branchlessPartition(a, n, [key](T x) { return x < key; });
+    }
+
+    // True if the keys are spread evenly enough for interpolation to land
+    // close to the answer: a sample of keys must sit within 1/32 of the
+    // array of where a straight line from the first to the last key puts them
+    template <typename T>
+    static bool isNearlyUniform(const T* a, size_t n) {
+        if (n < 2 || !(a[0] < a[n - 1])) return false;
+
+        const size_t SAMPLES = 64;
+        double low = (double)a[0];
+        double scale = (double)(n - 1) / ((double)a[n - 1] - low);
+        double limit = (double)n / 32.0;
+        for (size_t s = 1; s < SAMPLES; s++) {
+            size_t i = (size_t)((double)s / SAMPLES * (double)(n - 1));
+            double expected = ((double)a[i] - low) * scale;
+            double error = expected - (double)i;
+            if (error > limit || error < -limit) return false;
+        }
+        return true;
+    }
+
+    // Picks a method for repeated searches over these keys, from their
+    // count and measured spread. While the keys fit in the L2 cache the
+    // branchless binary search wins: its probes are cheap and its steps
+    // overlap. Past that every probe is a cache miss, so the method with
+    // the fewest dependent misses wins: interpolation (a few probes) on
+    // evenly spread keys, else the Eytzinger layout, which prefetches the
+    // levels ahead. Exponential search needs a starting point, so it is
+    // never picked here; callers use it for follow-up searches.
+    template <typename T>
+    static SearchMethod chooseMethod(const T* a, size_t n) {
+        if (n <= LINEAR_LIMIT) return SEARCH_LINEAR;
+        if (n * sizeof(T) <= CACHE_RESIDENT_BYTES) return SEARCH_BRANCHLESS;
+        if (isNearlyUniform(a, n)) return SEARCH_INTERPOLATION;
+        return SEARCH_EYTZINGER;
+    }
+
+    static const char* methodName(SearchMethod method) {
+        switch (method) {
+            case SEARCH_LINEAR: return "linear";
+            case SEARCH_BRANCHLESS: return "branchless binary";
+            case SEARCH_EYTZINGER: return "eytzinger";
+            case SEARCH_INTERPOLATION: return "interpolation";
+            case SEARCH_EXPONENTIAL: return "exponential";
+        }
+        return "unknown";
+    }
+
+private:
+    static const size_t CACHE_RESIDENT_BYTES = 256 * 1024;
+    static const size_t MAX_INTERPOLATION_PROBES = 32;
+
+    template <typename T>
+    static size_t interpolationSearch(const T* a, size_t n, T key, bool upper) {
+        auto before = [key, upper](T x) { return upper ? !(key < x) : x < key; };
+
+        if (n == 0 || !before(a[0])) return 0;
+        if (before(a[n - 1])) return n;
+
+        // The answer is in (low, high]. a[low] is before it and a[high] is
+        // not, so lowKey < highKey and every probe costs one memory read.
+        size_t low = 0;
+        size_t high = n - 1;
+        double lowKey = (double)a[low];
+        double highKey = (double)a[high];
+        size_t probesLeft = MAX_INTERPOLATION_PROBES;
+
+        while (high - low > LINEAR_LIMIT && probesLeft-- > 0) {
+            double fraction = ((double)key - lowKey) / (highKey - lowKey);
+            if (!(fraction > 0.0)) fraction = 0.0;
+            if (fraction > 1.0) fraction = 1.0;
+            size_t mid = low + 1 + (size_t)(fraction * (double)(high - low - 2));
+
+            // Selects rather than branches: which side a probe falls on is
+            // a coin flip, and a mispredict costs as much as the probe
+            double midKey = (double)a[mid];
+            bool right = before(a[mid]);
+            low = right ? mid : low;
+            lowKey = right ? midKey : lowKey;
+            high = right ? high : mid;
+            highKey = right ? highKey : midKey;
+        }
+        return low + 1 + branchlessPartition(a + low + 1, high - low - 1, before);
+    }
+};
+
+// Sorted keys copied in Eytzinger (breadth-first heap) order: the children
+// of slot k are 2k and 2k + 1, so the first levels of every search share a
+// few cache lines. The tree starts on a cache line, so the descendants of
+// slot k a few levels down (slots k * PREFETCH_STRIDE onwards) fill exactly
+// one line, which is prefetched while slot k is compared: three levels
+// ahead for 8-byte keys, four for 4-byte keys.
+template <typename T>
+class EytzingerLayout {
+private:
+    static const size_t CACHE_LINE = 64;
+    static_assert(sizeof(T) <= CACHE_LINE && CACHE_LINE % sizeof(T) == 0,
+                  "Keys must pack evenly into cache lines");
+    static const size_t PREFETCH_STRIDE = CACHE_LINE / sizeof(T);
+
+    std::vector<T> storage;       // The tree plus padding up to a cache line
+    size_t first;                 // storage[first] is tree slot 0, on a line boundary
+    size_t count;
+    std::vector<size_t> sorted;   // sorted[k] is the position of slot k in the input
+
+    const T* tree() const { return storage.data() + first; }
+
+public:
+    EytzingerLayout() : first(0), count(0) {}
+
+    // A copy would lose the alignment; moving keeps the buffer
+    EytzingerLayout(const EytzingerLayout&) = delete;
+    EytzingerLayout& operator=(const EytzingerLayout&) = delete;
+    EytzingerLayout(EytzingerLayout&&) = default;
+    EytzingerLayout& operator=(EytzingerLayout&&) = default;
+
+    // Copies n sorted keys; an in-order walk of the tree visits them in order
+    void build(const T* keys, size_t n) {
+        count = n;
+        storage.assign(n + 1 + PREFETCH_STRIDE, T());
+        sorted.assign(n + 1, 0);
+        size_t misaligned = (size_t)((uintptr_t)storage.data() % CACHE_LINE);
+        first = misaligned == 0 ? 0 : (CACHE_LINE - misaligned) / sizeof(T);
+        if (n == 0) return;
+
+        T* slots = storage.data() + first;   // 1-based; slot 0 is unused
+        size_t k = 1;
+        while (2 * k <= n) k *= 2;   // Leftmost slot holds the smallest key
+        for (size_t i = 0; i < n; i++) {
+            slots[k] = keys[i];
+            sorted[k] = i;
+
+            // In-order successor of slot k
+            if (2 * k + 1 <= n) {
+                k = 2 * k + 1;
+                while (2 * k <= n) k *= 2;
+            } else {
+                while (k & 1) k >>= 1;
+                k >>= 1;
+            }
+        }
+    }
+
+    // Same contract as SearchAlgorithms: the length of the prefix of the
+    // sorted keys for which before() holds
+    template <typename Before>
+    size_t partition(Before before) const {
+        const T* slots = tree();
+        size_t n = count;
+        size_t k = 1;
+        while (k <= n) {
+#if defined(__GNUC__)
+            if (k * PREFETCH_STRIDE <= n) __builtin_prefetch(&slots[k * PREFETCH_STRIDE]);
+#endif
+            k = 2 * k + (before(slots[k]) ? 1 : 0);
+        }
+        // The answer is the last slot where the search went left: drop the
+        // right turns taken after it, then that left turn
+        while (k & 1) k >>= 1;
+        k >>= 1;
+        return k == 0 ? n : sorted[k];
+    }
+
+    size_t size() const { return count; }
+};
+
+// A sorted numeric key array plus the search method picked for it, for
+// tables that are searched many times between changes. The keys are not
+// copied (except into the Eytzinger layout), so attach() again whenever
+// the array changes or moves.
+template <typename T>
+class SortedSearch {
+private:
+    const T* keys;
+    size_t count;
+    SearchMethod method;
+    EytzingerLayout<T> eytzinger;
+
+    template <typename Before>
+    size_t partition(Before before, T key, bool upper) const {
+        switch (method) {
+            case SEARCH_LINEAR:
+                return SearchAlgorithms::linearPartition(keys, count, before);
+            case SEARCH_EYTZINGER:
+                return eytzinger.partition(before);
+            case SEARCH_INTERPOLATION:
+                return upper ? SearchAlgorithms::interpolationUpperBound(keys, count, key)
+                             : SearchAlgorithms::interpolationLowerBound(keys, count, key);
+            case SEARCH_EXPONENTIAL:
+                return SearchAlgorithms::exponentialPartition(keys, count, before);
+            case SEARCH_BRANCHLESS:
+                break;
+        }
+        return SearchAlgorithms::branchlessPartition(keys, count, before);
+    }
+
+public:
+    SortedSearch() : keys(nullptr), count(0), method(SEARCH_LINEAR) {}
+
+    // Measures the keys and picks the method
+    void attach(const T* sortedKeys, size_t n) {
+        attach(sortedKeys, n, SearchAlgorithms::chooseMethod(sortedKeys, n));
+    }
+
+    void attach(const T* sortedKeys, size_t n, SearchMethod forced) {
+        keys = sortedKeys;
+        count = n;
+        method = forced;
+        if (method == SEARCH_EYTZINGER) eytzinger.build(keys, count);
+        else eytzinger.build(keys, 0);
+    }
+
+    // Position of the first key >= key
+    size_t lowerBound(T key) const {
+        return partition([key](T x) { return x < key; }, key, false);
+    }
+
+    // Position of the first key > key
+    size_t upperBound(T key) const {
+        return partition([key](T x) { return !(key < x); }, key, true);
+    }
+
+    // Position of the first key > key, for an answer known to be at or
+    // after from (e.g. the lower bound of the same range); costs O(log d)
+    // in the distance d from there
+    size_t upperBoundFrom(T key, size_t from) const {
+        return SearchAlgorithms::exponentialPartition(keys, count, [key](T x) { return !(key < x); }, from);
+    }
+
+    SearchMethod activeMethod() const { return method; }
+    size_t size() const { return count; }
+};
+
+#endif // SEARCH_ALGORITHMS_HPP
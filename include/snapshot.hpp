@@ -0,0 +1,749 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "csvReader.hpp"
+#include "columnScan.hpp"
+#include "transactionTable.hpp"
+
+// Binary snapshot of a cleaned dataset. The cleaners stream one next to the
+// clean CSV; loaders map it read-only and query the columns in place, so
+// start-up costs one mmap and a header check instead of a parse of every
+// line.
+//
+// Layout (native byte order, every section 8-byte aligned):
+//
+//   SnapshotHeader                 magic, version, kind, row count
+//   SnapshotSection[sectionCount]  id, offset and size of each section
+//   sections ...
+//
+// A section is either a fixed-width column (rowCount values of one type)
+// or a string list: uint64 count, uint64 offsets[count + 1], then the
+// bytes. String i is bytes[offsets[i], offsets[i + 1] - 1) followed by a
+// '\0', so it can also be read as a C string. String lists hold the
+// dictionaries of the encoded columns and the review text heap.
+//
+// Readers reject files with another magic, version, kind or byte order,
+// sections that fall outside the file, string lists whose offsets run
+// backwards or whose strings lack the '\0', and code columns holding a code
+// past the end of their dictionary. The code check is one pass over each
+// code column at open, so the accessors and scans can index the
+// dictionaries without checks.
+
+static const char SNAPSHOT_MAGIC[8] = {'D', 'S', 'S', 'N', 'A', 'P', '\0', '\0'};
+static const uint32_t SNAPSHOT_VERSION = 1;
+static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304u;
+
+enum SnapshotKind {
+    SNAPSHOT_TRANSACTIONS = 1,
+    SNAPSHOT_REVIEWS = 2
+};
+
+enum SnapshotSectionId {
+    // Transactions
+    SNAP_TX_CUSTOMER_DICT = 1,
+    SNAP_TX_CUSTOMER_CODES,
+    SNAP_TX_PRODUCT_DICT,
+    SNAP_TX_PRODUCT_CODES,
+    SNAP_TX_CATEGORY_DICT,
+    SNAP_TX_CATEGORY_CODES,
+    SNAP_TX_PRICES,
+    SNAP_TX_DATE_KEYS,
+    SNAP_TX_PAYMENT_DICT,
+    SNAP_TX_PAYMENT_CODES,
+
+    // Reviews
+    SNAP_RV_PRODUCT_DICT = 32,
+    SNAP_RV_PRODUCT_CODES,
+    SNAP_RV_CUSTOMER_DICT,
+    SNAP_RV_CUSTOMER_CODES,
+    SNAP_RV_RATINGS,
+    SNAP_RV_TEXT
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;      // SNAPSHOT_BYTE_ORDER as written
+    uint32_t kind;           // SnapshotKind
+    uint32_t sectionCount;
+    uint64_t rowCount;
+};
+
+struct SnapshotSection {
+    uint32_t id;
+    uint32_t reserved;
+    uint64_t offset;         // From the start of the file
+    uint64_t size;           // In bytes, without padding
+};
+
+// Streams sections to a new snapshot file. The header and section table
+// are reserved up front and filled in by finish(), so column data is
+// written once and never buffered.
+class SnapshotWriter {
+private:
+    std::ofstream out;
+    SnapshotHeader header;
+    std::vector<SnapshotSection> sections;
+    uint64_t position;
+    bool inSection;
+
+    void pad() {
+        static const char zeros[8] = {0};
+        size_t padding = (size_t)((8 - position % 8) % 8);
+        out.write(zeros, padding);
+        position += padding;
+    }
+
+public:
+    SnapshotWriter() : position(0), inSection(false) {}
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    // Creates the file and reserves room for sectionCount sections
+    bool open(const std::string& filename, SnapshotKind kind, uint64_t rowCount, uint32_t sectionCount) {
+        out.open(filename.c_str(), std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+        header.version = SNAPSHOT_VERSION;
+        header.byteOrder = SNAPSHOT_BYTE_ORDER;
+        header.kind = kind;
+        header.sectionCount = sectionCount;
+        header.rowCount = rowCount;
+
+        sections.clear();
+        sections.reserve(sectionCount);
+
+        // Placeholder header and table, rewritten by finish()
+        std::vector<char> zeros(sizeof(SnapshotHeader) + sectionCount * sizeof(SnapshotSection), 0);
+        out.write(zeros.data(), zeros.size());
+        position = zeros.size();
+        return out.good();
+    }
+
+    void beginSection(uint32_t id) {
+        pad();
+        SnapshotSection section = {id, 0, position, 0};
+        sections.push_back(section);
+        inSection = true;
+    }
+
+    void write(const void* data, size_t bytes) {
+        out.write((const char*)data, bytes);
+        position += bytes;
+    }
+
+    void endSection() {
+        sections.back().size = position - sections.back().offset;
+        inSection = false;
+    }
+
+    // A whole fixed-width column in one section
+    void writeColumn(uint32_t id, const void* data, size_t bytes) {
+        beginSection(id);
+        write(data, bytes);
+        endSection();
+    }
+
+    // A string list of count strings; getString(i) returns a FieldView and
+    // is called twice per string (lengths first, then bytes)
+    template <typename GetString>
+    void writeStrings(uint32_t id, uint64_t count, GetString getString) {
+        beginSection(id);
+        write(&count, sizeof(count));
+
+        uint64_t offset = 0;
+        write(&offset, sizeof(offset));
+        for (uint64_t i = 0; i < count; i++) {
+            offset += getString(i).len + 1;
+            write(&offset, sizeof(offset));
+        }
+
+        const char terminator = '\0';
+        for (uint64_t i = 0; i < count; i++) {
+            FieldView str = getString(i);
+            write(str.ptr, str.len);
+            write(&terminator, 1);
+        }
+        endSection();
+    }
+
+    // Writes the header and section table; false on any write error or if
+    // the section count does not match the one given to open()
+    bool finish() {
+        if (inSection || sections.size() != header.sectionCount) return false;
+        out.seekp(0);
+        out.write((const char*)&header, sizeof(header));
+        out.write((const char*)sections.data(), sections.size() * sizeof(SnapshotSection));
+        bool ok = out.good();
+        out.close();
+        return ok;
+    }
+};
+
+// Append-only temporary file beside the snapshot being built. Columns are
+// spilled here row by row and copied into their sections at the end, so a
+// builder's memory does not grow with the row count. The file is removed
+// when the SpillFile is destroyed.
+class SpillFile {
+private:
+    std::string path;
+    std::fstream stream;
+    uint64_t bytes;
+
+public:
+    SpillFile() : bytes(0) {}
+
+    ~SpillFile() {
+        close();
+    }
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    bool open(const std::string& filename) {
+        close();
+        path = filename;
+        bytes = 0;
+        stream.open(path.c_str(), std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+        return stream.is_open();
+    }
+
+    void close() {
+        if (stream.is_open()) stream.close();
+        if (!path.empty()) std::remove(path.c_str());
+        path.clear();
+    }
+
+    void write(const void* data, size_t n) {
+        stream.write((const char*)data, n);
+        bytes += n;
+    }
+
+    uint64_t size() const { return bytes; }
+    bool good() const { return stream.good(); }
+
+    // Appends everything written so far to the writer's current section
+    bool copyTo(SnapshotWriter& writer) {
+        char chunk[1 << 16];
+        stream.flush();
+        stream.seekg(0);
+        uint64_t left = bytes;
+        while (left > 0 && stream.good()) {
+            size_t n = left < sizeof(chunk) ? (size_t)left : sizeof(chunk);
+            stream.read(chunk, n);
+            writer.write(chunk, n);
+            left -= n;
+        }
+        return left == 0;
+    }
+};
+
+// Read-only string list inside a mapped snapshot
+class SnapshotStrings {
+private:
+    const uint64_t* offsets;
+    const char* bytes;
+    size_t count;
+
+public:
+    SnapshotStrings() : offsets(nullptr), bytes(nullptr), count(0) {}
+
+    // Points the view at a string list section; false if it is malformed
+    bool attach(const char* data, size_t size) {
+        if (size < sizeof(uint64_t)) return false;
+        uint64_t n;
+        memcpy(&n, data, sizeof(n));
+
+        size_t header = sizeof(uint64_t) * (n + 2);
+        if (n > size / sizeof(uint64_t) || header > size) return false;
+
+        const uint64_t* table = (const uint64_t*)(data + sizeof(uint64_t));
+        if (table[0] != 0 || table[n] != size - header) return false;
+
+        // Every string takes at least its '\0', so the offsets must rise
+        const char* strings = data + header;
+        for (uint64_t i = 0; i < n; i++) {
+            if (table[i + 1] <= table[i] || strings[table[i + 1] - 1] != '\0') return false;
+        }
+
+        offsets = table;
+        bytes = strings;
+        count = (size_t)n;
+        return true;
+    }
+
+    FieldView operator[](size_t i) const {
+        return FieldView(bytes + offsets[i], (size_t)(offsets[i + 1] - offsets[i] - 1));
+    }
+
+    const char* c_str(size_t i) const { return bytes + offsets[i]; }
+    size_t size() const { return count; }
+
+    // Index of a string, by linear search; meant for the small dictionaries
+    bool find(const char* str, size_t len, uint32_t& index) const {
+        for (size_t i = 0; i < count; i++) {
+            if (offsets[i + 1] - offsets[i] - 1 == len && memcmp(bytes + offsets[i], str, len) == 0) {
+                index = (uint32_t)i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool find(const char* str, uint32_t& index) const { return find(str, strlen(str), index); }
+};
+
+// A mapped snapshot file: validates the header and hands out sections
+class SnapshotFile {
+private:
+    MappedFile file;
+    const SnapshotHeader* header;
+    const SnapshotSection* sections;
+
+public:
+    SnapshotFile() : header(nullptr), sections(nullptr) {}
+
+    SnapshotFile(const SnapshotFile&) = delete;
+    SnapshotFile& operator=(const SnapshotFile&) = delete;
+
+    bool open(const std::string& filename, SnapshotKind kind) {
+        header = nullptr;
+        sections = nullptr;
+        if (!file.open(filename) || file.size() < sizeof(SnapshotHeader)) return false;
+
+        const SnapshotHeader* h = (const SnapshotHeader*)file.begin();
+        if (memcmp(h->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+            h->version != SNAPSHOT_VERSION || h->byteOrder != SNAPSHOT_BYTE_ORDER ||
+            h->kind != (uint32_t)kind) return false;
+
+        size_t tableEnd = sizeof(SnapshotHeader) + (size_t)h->sectionCount * sizeof(SnapshotSection);
+        if (tableEnd > file.size()) return false;
+
+        const SnapshotSection* table = (const SnapshotSection*)(file.begin() + sizeof(SnapshotHeader));
+        for (uint32_t i = 0; i < h->sectionCount; i++) {
+            if (table[i].offset % 8 != 0 || table[i].offset < tableEnd ||
+                table[i].offset > file.size() || table[i].size > file.size() - table[i].offset) return false;
+        }
+
+        header = h;
+        sections = table;
+        return true;
+    }
+
+    bool isOpen() const { return header != nullptr; }
+    size_t rowCount() const { return header ? (size_t)header->rowCount : 0; }
+
+    // Start and size of a section; false if the file has no such section
+    bool section(uint32_t id, const char*& data, size_t& size) const {
+        if (!header) return false;
+        for (uint32_t i = 0; i < header->sectionCount; i++) {
+            if (sections[i].id == id) {
+                data = file.begin() + sections[i].offset;
+                size = (size_t)sections[i].size;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // A column of rowCount() values of T
+    template <typename T>
+    bool column(uint32_t id, const T*& values) const {
+        const char* data;
+        size_t size;
+        if (!section(id, data, size) || size != rowCount() * sizeof(T)) return false;
+        values = (const T*)data;
+        return true;
+    }
+
+    bool strings(uint32_t id, SnapshotStrings& out) const {
+        const char* data;
+        size_t size;
+        return section(id, data, size) && out.attach(data, size);
+    }
+
+    // A column of dictionary codes, each below dictionarySize
+    template <typename Code>
+    bool codes(uint32_t id, size_t dictionarySize, const Code*& values) const {
+        if (!column(id, values)) return false;
+        size_t n = rowCount();
+        if (n == 0) return true;
+        if (dictionarySize == 0) return false;
+
+        // A max reduction, so the pass vectorizes
+        Code highest = 0;
+        for (size_t i = 0; i < n; i++) highest = values[i] > highest ? values[i] : highest;
+        return (size_t)highest < dictionarySize;
+    }
+};
+
+// ---- Transactions ----
+
+// True if value already has a code, or the dictionary still has room for
+// one more in Code (see DictionaryColumn::canEncode)
+template <typename Code>
+inline bool canSpillDictionaryCode(const StringInterner& dictionary, const FieldView& value) {
+    if ((uint64_t)dictionary.size() <= (uint64_t)std::numeric_limits<Code>::max()) return true;
+    uint32_t id;
+    return dictionary.find(value.ptr, value.len, id);
+}
+
+// Appends a value's dictionary code to a spilled code column. Callers check
+// canSpillDictionaryCode first, for every column of the row, so a row that
+// overflows writes nothing.
+template <typename Code>
+inline void spillDictionaryCode(StringInterner& dictionary, SpillFile& codes, const FieldView& value) {
+    Code code = (Code)dictionary.intern(value.ptr, value.len);
+    codes.write(&code, sizeof(code));
+}
+
+// Writes a dictionary as a string list section
+inline void writeDictionary(SnapshotWriter& writer, uint32_t id, const StringInterner& dictionary) {
+    writer.writeStrings(id, dictionary.size(), [&](uint64_t i) {
+        return FieldView(dictionary.key((uint32_t)i), dictionary.keyLength((uint32_t)i));
+    });
+}
+
+inline bool copySection(SnapshotWriter& writer, uint32_t id, SpillFile& spill) {
+    writer.beginSection(id);
+    bool ok = spill.copyTo(writer);
+    writer.endSection();
+    return ok;
+}
+
+// Builds a transactions snapshot one row at a time. Only the dictionaries
+// are kept in memory; the columns are spilled to temporary files next to
+// the target and copied into place by finish(). Codes use the widths of
+// TransactionTable.
+class TransactionSnapshotBuilder {
+public:
+    typedef TransactionTable::CustomerCode CustomerCode;
+    typedef TransactionTable::ProductCode ProductCode;
+    typedef TransactionTable::CategoryCode CategoryCode;
+    typedef TransactionTable::PaymentCode PaymentCode;
+
+private:
+    std::string target;
+    StringInterner customers, products, categories, payments;
+    SpillFile customerCodes, productCodes, categoryCodes, prices, dateKeys, paymentCodes;
+    uint64_t rows;
+
+public:
+    TransactionSnapshotBuilder() : rows(0) {}
+
+    bool open(const std::string& filename) {
+        target = filename;
+        rows = 0;
+        return customerCodes.open(filename + ".customer.part") &&
+               productCodes.open(filename + ".product.part") &&
+               categoryCodes.open(filename + ".category.part") &&
+               prices.open(filename + ".price.part") &&
+               dateKeys.open(filename + ".date.part") &&
+               paymentCodes.open(filename + ".payment.part");
+    }
+
+    // Throws std::overflow_error when a dictionary outgrows its code width,
+    // like TransactionTable::append; the row is then not written at all
+    void append(const FieldView& customerID, const FieldView& product, const FieldView& category,
+                double price, uint32_t dateKey, const FieldView& paymentMethod) {
+        if (!canSpillDictionaryCode<CustomerCode>(customers, customerID) ||
+            !canSpillDictionaryCode<ProductCode>(products, product) ||
+            !canSpillDictionaryCode<CategoryCode>(categories, category) ||
+            !canSpillDictionaryCode<PaymentCode>(payments, paymentMethod)) {
+            throw std::overflow_error("Too many distinct values for dictionary column");
+        }
+
+        spillDictionaryCode<CustomerCode>(customers, customerCodes, customerID);
+        spillDictionaryCode<ProductCode>(products, productCodes, product);
+        spillDictionaryCode<CategoryCode>(categories, categoryCodes, category);
+        prices.write(&price, sizeof(price));
+        dateKeys.write(&dateKey, sizeof(dateKey));
+        spillDictionaryCode<PaymentCode>(payments, paymentCodes, paymentMethod);
+        rows++;
+    }
+
+    uint64_t size() const { return rows; }
+
+    // Drops the snapshot: removes the spill files and any older snapshot at
+    // the target, so loaders fall back to the clean CSV
+    void abandon() {
+        std::remove(target.c_str());
+        customerCodes.close();
+        productCodes.close();
+        categoryCodes.close();
+        prices.close();
+        dateKeys.close();
+        paymentCodes.close();
+    }
+
+    // Writes the snapshot and removes the spill files
+    bool finish() {
+        SnapshotWriter writer;
+        bool ok = writer.open(target, SNAPSHOT_TRANSACTIONS, rows, 10);
+        if (ok) {
+            writeDictionary(writer, SNAP_TX_CUSTOMER_DICT, customers);
+            ok = copySection(writer, SNAP_TX_CUSTOMER_CODES, customerCodes) && ok;
+            writeDictionary(writer, SNAP_TX_PRODUCT_DICT, products);
+            ok = copySection(writer, SNAP_TX_PRODUCT_CODES, productCodes) && ok;
+            writeDictionary(writer, SNAP_TX_CATEGORY_DICT, categories);
+            ok = copySection(writer, SNAP_TX_CATEGORY_CODES, categoryCodes) && ok;
+            ok = copySection(writer, SNAP_TX_PRICES, prices) && ok;
+            ok = copySection(writer, SNAP_TX_DATE_KEYS, dateKeys) && ok;
+            writeDictionary(writer, SNAP_TX_PAYMENT_DICT, payments);
+            ok = copySection(writer, SNAP_TX_PAYMENT_CODES, paymentCodes) && ok;
+            ok = writer.finish() && ok;
+        }
+
+        customerCodes.close();
+        productCodes.close();
+        categoryCodes.close();
+        prices.close();
+        dateKeys.close();
+        paymentCodes.close();
+        return ok;
+    }
+};
+
+// A transactions snapshot mapped in place. Offers the scans of
+// TransactionTable over the mapped columns; nothing is copied.
+class TransactionSnapshot {
+public:
+    typedef TransactionTable::CustomerCode CustomerCode;
+    typedef TransactionTable::ProductCode ProductCode;
+    typedef TransactionTable::CategoryCode CategoryCode;
+    typedef TransactionTable::PaymentCode PaymentCode;
+
+private:
+    SnapshotFile file;
+    SnapshotStrings customerNames, productNames, categoryNames, paymentNames;
+    const CustomerCode* customerCodes;
+    const ProductCode* productCodes;
+    const CategoryCode* categoryCodes;
+    const double* prices;
+    const uint32_t* dateKeys;
+    const PaymentCode* paymentCodes;
+
+public:
+    TransactionSnapshot()
+        : customerCodes(nullptr), productCodes(nullptr), categoryCodes(nullptr),
+          prices(nullptr), dateKeys(nullptr), paymentCodes(nullptr) {}
+
+    // Maps the file; false if it is missing, of another version, or damaged
+    bool open(const std::string& filename) {
+        return file.open(filename, SNAPSHOT_TRANSACTIONS) &&
+               file.strings(SNAP_TX_CUSTOMER_DICT, customerNames) &&
+               file.codes(SNAP_TX_CUSTOMER_CODES, customerNames.size(), customerCodes) &&
+               file.strings(SNAP_TX_PRODUCT_DICT, productNames) &&
+               file.codes(SNAP_TX_PRODUCT_CODES, productNames.size(), productCodes) &&
+               file.strings(SNAP_TX_CATEGORY_DICT, categoryNames) &&
+               file.codes(SNAP_TX_CATEGORY_CODES, categoryNames.size(), categoryCodes) &&
+               file.column(SNAP_TX_PRICES, prices) &&
+               file.column(SNAP_TX_DATE_KEYS, dateKeys) &&
+               file.strings(SNAP_TX_PAYMENT_DICT, paymentNames) &&
+               file.codes(SNAP_TX_PAYMENT_CODES, paymentNames.size(), paymentCodes);
+    }
+
+    size_t size() const { return file.rowCount(); }
+    bool empty() const { return size() == 0; }
+
+    // Single fields of one row
+    FieldView customerID(size_t row) const { return customerNames[customerCodes[row]]; }
+    FieldView product(size_t row) const { return productNames[productCodes[row]]; }
+    FieldView category(size_t row) const { return categoryNames[categoryCodes[row]]; }
+    double price(size_t row) const { return prices[row]; }
+    uint32_t dateKey(size_t row) const { return dateKeys[row]; }
+    FieldView paymentMethod(size_t row) const { return paymentNames[paymentCodes[row]]; }
+
+    // Whole columns
+    const double* priceData() const { return prices; }
+    const uint32_t* dateKeyData() const { return dateKeys; }
+    const CategoryCode* categoryCodeData() const { return categoryCodes; }
+    const PaymentCode* paymentCodeData() const { return paymentCodes; }
+
+    // ---- Scans (same results as TransactionTable) ----
+
+    void countCategoryPayment(const char* category, const char* paymentMethod,
+                              size_t& inCategory, size_t& withPayment) const {
+        inCategory = 0;
+        withPayment = 0;
+
+        uint32_t categoryCode, paymentCode;
+        if (!categoryNames.find(category, categoryCode)) return;
+
+        CodeEquals terms[2] = {
+            {categoryCodes, (uint8_t)categoryCode},
+            {paymentCodes, 0}
+        };
+        inCategory = ColumnScan::countAll(terms, 1, size());
+        if (paymentNames.find(paymentMethod, paymentCode)) {
+            terms[1].value = (uint8_t)paymentCode;
+            withPayment = ColumnScan::countAll(terms, 2, size());
+        }
+    }
+
+    size_t countCategory(const char* category) const {
+        uint32_t categoryCode;
+        if (!categoryNames.find(category, categoryCode)) return 0;
+        return ColumnScan::countEqual(categoryCodes, size(), (uint8_t)categoryCode);
+    }
+
+    size_t categoryCount() const { return categoryNames.size(); }
+    size_t paymentMethodCount() const { return paymentNames.size(); }
+    FieldView categoryName(CategoryCode code) const { return categoryNames[code]; }
+    FieldView paymentMethodName(PaymentCode code) const { return paymentNames[code]; }
+
+    // counts[categoryCode * paymentMethodCount() + paymentCode]
+    void crossTabCategoryPayment(size_t* counts) const {
+        ColumnScan::crossTab(categoryCodes, categoryCount(), paymentCodes, paymentMethodCount(), size(), counts);
+    }
+
+    double totalPrice() const { return ColumnScan::sum(prices, size()); }
+
+    size_t countInDateRange(uint32_t fromKey, uint32_t toKey, double* priceTotal = nullptr) const {
+        return ColumnScan::countInRange(dateKeys, prices, size(), fromKey, toKey, priceTotal);
+    }
+};
+
+// ---- Reviews ----
+
+// Builds a reviews snapshot one review at a time, spilling the columns and
+// the text heap like TransactionSnapshotBuilder. Product and customer ids
+// are dictionary-encoded.
+class ReviewSnapshotBuilder {
+private:
+    std::string target;
+    StringInterner products, customers;
+    SpillFile productCodes, customerCodes, ratings;
+    SpillFile textEnds;    // uint64 end of each text (terminator included)
+    SpillFile textBytes;   // Texts, each followed by '\0'
+    uint64_t rows;
+
+public:
+    ReviewSnapshotBuilder() : rows(0) {}
+
+    bool open(const std::string& filename) {
+        target = filename;
+        rows = 0;
+        return productCodes.open(filename + ".product.part") &&
+               customerCodes.open(filename + ".customer.part") &&
+               ratings.open(filename + ".rating.part") &&
+               textEnds.open(filename + ".textEnd.part") &&
+               textBytes.open(filename + ".text.part");
+    }
+
+    // Throws std::overflow_error, writing nothing, when a dictionary is full
+    void append(const FieldView& productID, const FieldView& customerID, int rating, const FieldView& text) {
+        if (!canSpillDictionaryCode<uint32_t>(products, productID) ||
+            !canSpillDictionaryCode<uint32_t>(customers, customerID)) {
+            throw std::overflow_error("Too many distinct values for dictionary column");
+        }
+
+        spillDictionaryCode<uint32_t>(products, productCodes, productID);
+        spillDictionaryCode<uint32_t>(customers, customerCodes, customerID);
+        uint8_t ratingByte = (uint8_t)rating;
+        ratings.write(&ratingByte, 1);
+
+        const char terminator = '\0';
+        textBytes.write(text.ptr, text.len);
+        textBytes.write(&terminator, 1);
+        uint64_t end = textBytes.size();
+        textEnds.write(&end, sizeof(end));
+        rows++;
+    }
+
+    uint64_t size() const { return rows; }
+
+    // Drops the snapshot, like TransactionSnapshotBuilder::abandon
+    void abandon() {
+        std::remove(target.c_str());
+        productCodes.close();
+        customerCodes.close();
+        ratings.close();
+        textEnds.close();
+        textBytes.close();
+    }
+
+    // Writes the snapshot and removes the spill files
+    bool finish() {
+        SnapshotWriter writer;
+        bool ok = writer.open(target, SNAPSHOT_REVIEWS, rows, 6);
+        if (ok) {
+            writeDictionary(writer, SNAP_RV_PRODUCT_DICT, products);
+            ok = copySection(writer, SNAP_RV_PRODUCT_CODES, productCodes) && ok;
+            writeDictionary(writer, SNAP_RV_CUSTOMER_DICT, customers);
+            ok = copySection(writer, SNAP_RV_CUSTOMER_CODES, customerCodes) && ok;
+            ok = copySection(writer, SNAP_RV_RATINGS, ratings) && ok;
+
+            // String list layout: count, offsets[0] = 0, the ends, then the bytes
+            uint64_t zero = 0;
+            writer.beginSection(SNAP_RV_TEXT);
+            writer.write(&rows, sizeof(rows));
+            writer.write(&zero, sizeof(zero));
+            ok = textEnds.copyTo(writer) && ok;
+            ok = textBytes.copyTo(writer) && ok;
+            writer.endSection();
+            ok = writer.finish() && ok;
+        }
+
+        productCodes.close();
+        customerCodes.close();
+        ratings.close();
+        textEnds.close();
+        textBytes.close();
+        return ok;
+    }
+};
+
+// A reviews snapshot mapped in place. Review texts are '\0'-terminated
+// inside the mapping, so they can be handed to C-string tokenizers as is.
+class ReviewSnapshot {
+private:
+    SnapshotFile file;
+    SnapshotStrings productNames, customerNames, texts;
+    const uint32_t* productCodes;
+    const uint32_t* customerCodes;
+    const uint8_t* ratings;
+
+public:
+    ReviewSnapshot() : productCodes(nullptr), customerCodes(nullptr), ratings(nullptr) {}
+
+    bool open(const std::string& filename) {
+        return file.open(filename, SNAPSHOT_REVIEWS) &&
+               file.strings(SNAP_RV_PRODUCT_DICT, productNames) &&
+               file.codes(SNAP_RV_PRODUCT_CODES, productNames.size(), productCodes) &&
+               file.strings(SNAP_RV_CUSTOMER_DICT, customerNames) &&
+               file.codes(SNAP_RV_CUSTOMER_CODES, customerNames.size(), customerCodes) &&
+               file.column(SNAP_RV_RATINGS, ratings) &&
+               file.strings(SNAP_RV_TEXT, texts) && texts.size() == size();
+    }
+
+    size_t size() const { return file.rowCount(); }
+    bool empty() const { return size() == 0; }
+
+    FieldView productID(size_t row) const { return productNames[productCodes[row]]; }
+    FieldView customerID(size_t row) const { return customerNames[customerCodes[row]]; }
+    int rating(size_t row) const { return ratings[row]; }
+    FieldView text(size_t row) const { return texts[row]; }
+    const char* textCStr(size_t row) const { return texts.c_str(row); }
+
+    const uint8_t* ratingData() const { return ratings; }
+
+    size_t countRating(int rating) const {
+        if (rating < 0 || rating > 255) return 0;
+        return ColumnScan::countEqual(ratings, size(), (uint8_t)rating);
+    }
+};
+
+#endif // SNAPSHOT_HPP
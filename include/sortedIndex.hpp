@@ -0,0 +1,147 @@
+#ifndef SORTED_INDEX_HPP
+#define SORTED_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "linkedList.hpp"
+#include "radixSort.hpp"
+#include "searchAlgorithms.hpp"
+
+// Rows of a sorted index that fall in one key range, in key order
+struct IndexRange {
+    const size_t* first;
+    const size_t* last;
+
+    const size_t* begin() const { return first; }
+    const size_t* end() const { return last; }
+    size_t size() const { return (size_t)(last - first); }
+    bool empty() const { return first == last; }
+};
+
+// Secondary index over a TransactionArray: the row numbers ordered by one
+// RadixKey, with the keys copied next to them so a search reads only one
+// packed array and never touches the rows. The base array is never
+// reordered. Queries use the SortedSearch method picked for the keys:
+// interpolation on evenly spread keys (near O(1)), a branchless or
+// Eytzinger binary search otherwise (O(log n)).
+//
+// The index holds row numbers, so it goes stale if rows are moved (sorted,
+// removed) and must then be built again. Appended rows are picked up by
+// refresh(), which sorts only the new rows and merges them in.
+//
+// Keys are RadixSort::extractKey values: dateKey (yyyymmdd) for
+// RADIX_BY_DATE, whole cents for RADIX_BY_PRICE (see priceKey()).
+class SortedIndex {
+private:
+    RadixKey keyKind;
+    std::vector<uint64_t> keys;   // Ascending
+    std::vector<size_t> rows;     // rows[i] holds keys[i]; equal keys in row order
+    SortedSearch<uint64_t> search;
+
+    // Sorts rows [from, to) of the array into parallel key/row arrays
+    void sortedRows(const TransactionArray& transactions, size_t from, size_t to,
+                    std::vector<uint64_t>& outKeys, std::vector<size_t>& outRows) const {
+        size_t n = to - from;
+        outKeys.resize(n);
+        outRows.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            outKeys[i] = RadixSort::extractKey(transactions[from + i], keyKind);
+            outRows[i] = from + i;
+        }
+        if (n > 0) RadixSort::sortKeys(outKeys.data(), outRows.data(), n);
+    }
+
+public:
+    explicit SortedIndex(RadixKey key = RADIX_BY_DATE) : keyKind(key) {}
+
+    // The searcher points into keys, which a copy would not carry over
+    SortedIndex(const SortedIndex&) = delete;
+    SortedIndex& operator=(const SortedIndex&) = delete;
+    SortedIndex(SortedIndex&&) = default;
+    SortedIndex& operator=(SortedIndex&&) = default;
+
+    // Indexes every row of the array, replacing the old index. Linear time:
+    // the keys are radix sorted.
+    void build(const TransactionArray& transactions) {
+        sortedRows(transactions, 0, transactions.size(), keys, rows);
+        search.attach(keys.data(), keys.size());
+    }
+
+    // Indexes the rows appended since the last build or refresh. The new
+    // rows are sorted on their own and merged in from the back, so the cost
+    // is O(new + size) with no re-sort of the indexed rows.
+    void refresh(const TransactionArray& transactions) {
+        size_t oldSize = rows.size();
+        if (transactions.size() <= oldSize) return;
+
+        std::vector<uint64_t> newKeys;
+        std::vector<size_t> newRows;
+        sortedRows(transactions, oldSize, transactions.size(), newKeys, newRows);
+
+        keys.resize(oldSize + newKeys.size());
+        rows.resize(keys.size());
+
+        // Fill from the back. New rows have higher row numbers, so they win
+        // ties here and equal keys stay in row order.
+        size_t a = oldSize;
+        size_t b = newKeys.size();
+        size_t out = keys.size();
+        while (b > 0) {
+            if (a > 0 && keys[a - 1] > newKeys[b - 1]) {
+                keys[--out] = keys[--a];
+                rows[out] = rows[a];
+            } else {
+                keys[--out] = newKeys[--b];
+                rows[out] = newRows[b];
+            }
+        }
+        search.attach(keys.data(), keys.size());
+    }
+
+    // Position of the first key >= key, i.e. the number of keys below it
+    size_t lowerBound(uint64_t key) const { return search.lowerBound(key); }
+
+    // Position of the first key > key
+    size_t upperBound(uint64_t key) const { return search.upperBound(key); }
+
+    // Rows with from <= key <= to, in key order
+    IndexRange between(uint64_t from, uint64_t to) const {
+        const size_t* base = rows.data();
+        if (to < from) return IndexRange{base, base};
+        // The end is found by galloping from the start, so narrow ranges
+        // cost one search plus O(log range)
+        size_t first = lowerBound(from);
+        return IndexRange{base + first, base + search.upperBoundFrom(to, first)};
+    }
+
+    // Rows with exactly this key
+    IndexRange equalTo(uint64_t key) const {
+        return between(key, key);
+    }
+
+    // Number of rows with from <= key <= to
+    size_t count(uint64_t from, uint64_t to) const {
+        return between(from, to).size();
+    }
+
+    // Row with the k-th smallest key (k from 0); k < size()
+    size_t kth(size_t k) const { return rows[k]; }
+    uint64_t keyAt(size_t k) const { return keys[k]; }
+
+    // Number of keys below key
+    size_t rank(uint64_t key) const { return lowerBound(key); }
+
+    const uint64_t* keyData() const { return keys.data(); }
+    const size_t* rowData() const { return rows.data(); }
+
+    RadixKey key() const { return keyKind; }
+    SearchMethod searchMethod() const { return search.activeMethod(); }
+    size_t size() const { return rows.size(); }
+    bool empty() const { return rows.empty(); }
+
+    // Key of a price in a RADIX_BY_PRICE index
+    static uint64_t priceKey(double price) { return RadixSort::priceToCents(price); }
+};
+
+#endif // SORTED_INDEX_HPP
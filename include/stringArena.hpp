@@ -0,0 +1,133 @@
+#ifndef STRING_ARENA_HPP
+#define STRING_ARENA_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+// Bump allocator for strings that share one lifetime (e.g. everything loaded
+// from one file). Strings are copied into large blocks and released together
+// when the arena is cleared or destroyed; there is no per-string free.
+// Not thread-safe: parallel loaders use one arena per worker and absorb()
+// them into the dataset's arena afterwards.
+class StringArena {
+private:
+    struct Block {
+        Block* next;
+        size_t capacity;
+        size_t used;
+
+        char* bytes() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    Block* head;        // Block currently being filled; older blocks follow
+    size_t blockSize;
+    size_t totalBytes;
+
+    Block* newBlock(size_t capacity) {
+        Block* block = static_cast<Block*>(::operator new(sizeof(Block) + capacity));
+        block->next = nullptr;
+        block->capacity = capacity;
+        block->used = 0;
+        return block;
+    }
+
+public:
+    explicit StringArena(size_t blockBytes = DEFAULT_BLOCK_SIZE)
+        : head(nullptr), blockSize(blockBytes), totalBytes(0) {}
+
+    ~StringArena() {
+        clear();
+    }
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    StringArena(StringArena&& other) noexcept
+        : head(other.head), blockSize(other.blockSize), totalBytes(other.totalBytes) {
+        other.head = nullptr;
+        other.totalBytes = 0;
+    }
+
+    StringArena& operator=(StringArena&& other) noexcept {
+        if (this != &other) {
+            clear();
+            head = other.head;
+            blockSize = other.blockSize;
+            totalBytes = other.totalBytes;
+            other.head = nullptr;
+            other.totalBytes = 0;
+        }
+        return *this;
+    }
+
+    // Returns uninitialised storage for bytes characters
+    char* allocate(size_t bytes) {
+        if (!head || head->capacity - head->used < bytes) {
+            if (bytes > blockSize / 4) {
+                // Large strings get a block of their own behind the current one
+                // so the remaining space of the current block is not wasted
+                Block* block = newBlock(bytes);
+                block->used = bytes;
+                totalBytes += bytes;
+                if (head) {
+                    block->next = head->next;
+                    head->next = block;
+                } else {
+                    head = block;
+                }
+                return block->bytes();
+            }
+            Block* block = newBlock(blockSize);
+            block->next = head;
+            head = block;
+        }
+
+        char* result = head->bytes() + head->used;
+        head->used += bytes;
+        totalBytes += bytes;
+        return result;
+    }
+
+    // Copies len bytes into the arena and null-terminates them
+    char* store(const char* str, size_t len) {
+        char* result = allocate(len + 1);
+        memcpy(result, str, len);
+        result[len] = '\0';
+        return result;
+    }
+
+    // Takes ownership of all blocks of other; strings stored in other stay valid
+    void absorb(StringArena& other) {
+        if (!other.head) return;
+
+        Block* last = other.head;
+        while (last->next) last = last->next;
+        // Keep our current block in front so it keeps being filled
+        if (head) {
+            last->next = head->next;
+            head->next = other.head;
+        } else {
+            head = other.head;
+        }
+        totalBytes += other.totalBytes;
+        other.head = nullptr;
+        other.totalBytes = 0;
+    }
+
+    // Frees every block at once. Strings handed out before become invalid.
+    void clear() {
+        while (head) {
+            Block* next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+        totalBytes = 0;
+    }
+
+    size_t bytesUsed() const { return totalBytes; }
+};
+
+#endif // STRING_ARENA_HPP
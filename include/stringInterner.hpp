@@ -0,0 +1,107 @@
+#ifndef STRING_INTERNER_HPP
+#define STRING_INTERNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "stringArena.hpp"
+
+// Maps strings to dense ids 0, 1, 2, ... in first-seen order.
+// Open addressing with linear probing over a power-of-two table of
+// (hash, id) slots; the characters of every key are stored once in a
+// StringArena, so a lookup touches one slot array and one key.
+class StringInterner {
+private:
+    struct Slot {
+        uint32_t hash;
+        uint32_t idPlusOne;   // 0 marks an empty slot
+    };
+
+    std::vector<Slot> slots;
+    std::vector<const char*> keys;
+    std::vector<uint32_t> lengths;
+    StringArena arena;
+
+    void rehash(size_t newCapacity) {
+        std::vector<Slot> newSlots(newCapacity);
+        size_t mask = newCapacity - 1;
+        for (size_t i = 0; i < slots.size(); i++) {
+            if (slots[i].idPlusOne == 0) continue;
+            size_t pos = slots[i].hash & mask;
+            while (newSlots[pos].idPlusOne != 0) pos = (pos + 1) & mask;
+            newSlots[pos] = slots[i];
+        }
+        slots.swap(newSlots);
+    }
+
+    // Slot holding the key, or the empty slot where it would go
+    size_t probe(const char* str, size_t len, uint32_t hash) const {
+        size_t mask = slots.size() - 1;
+        size_t pos = hash & mask;
+        while (true) {
+            const Slot& slot = slots[pos];
+            if (slot.idPlusOne == 0) return pos;
+            if (slot.hash == hash) {
+                uint32_t id = slot.idPlusOne - 1;
+                if (lengths[id] == len && memcmp(keys[id], str, len) == 0) return pos;
+            }
+            pos = (pos + 1) & mask;
+        }
+    }
+
+public:
+    StringInterner() : slots(64) {}
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    // FNV-1a, 32 bit
+    static uint32_t hashOf(const char* str, size_t len) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < len; i++) {
+            hash ^= (unsigned char)str[i];
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // Returns the id of the key, adding it if it is new
+    uint32_t intern(const char* str, size_t len) {
+        uint32_t hash = hashOf(str, len);
+        size_t pos = probe(str, len, hash);
+        if (slots[pos].idPlusOne != 0) return slots[pos].idPlusOne - 1;
+
+        uint32_t id = (uint32_t)keys.size();
+        keys.push_back(arena.store(str, len));
+        lengths.push_back((uint32_t)len);
+        slots[pos].hash = hash;
+        slots[pos].idPlusOne = id + 1;
+
+        // Keep the load factor at or below one half
+        if (keys.size() * 2 > slots.size()) rehash(slots.size() * 2);
+        return id;
+    }
+
+    // Looks up a key without adding it
+    bool find(const char* str, size_t len, uint32_t& id) const {
+        size_t pos = probe(str, len, hashOf(str, len));
+        if (slots[pos].idPlusOne == 0) return false;
+        id = slots[pos].idPlusOne - 1;
+        return true;
+    }
+
+    // Null-terminated characters of an id
+    const char* key(uint32_t id) const { return keys[id]; }
+    size_t keyLength(uint32_t id) const { return lengths[id]; }
+    size_t size() const { return keys.size(); }
+
+    void clear() {
+        slots.assign(64, Slot());
+        keys.clear();
+        lengths.clear();
+        arena.clear();
+    }
+};
+
+#endif // STRING_INTERNER_HPP
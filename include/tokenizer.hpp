@@ -0,0 +1,294 @@
+#ifndef TOKENIZER_HPP
+#define TOKENIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "cpuFeatures.hpp"
+
+// ASCII tokenizer for review text. Text is classified 32 bytes at a time
+// into letter / digit / space / other bit masks (AVX2 or SSE2 when the CPU
+// has them, plain byte tests otherwise) and tokens are found from the mask
+// edges, so the inner loop handles whole blocks instead of single chars.
+// Tokens are reported as spans into the input; nothing is allocated.
+//
+// Classes follow the "C" locale: letters A-Z a-z, digits 0-9, spaces
+// ' ' \t \n \v \f \r. Every other byte, including bytes >= 0x80, is "other".
+class Tokenizer {
+public:
+    enum CharClass {
+        LETTER = 1,
+        DIGIT = 2,
+        SPACE = 4,
+        OTHER = 8,
+        ALNUM = LETTER | DIGIT,
+        NON_SPACE = LETTER | DIGIT | OTHER
+    };
+
+    // Name of the kernel picked for this CPU: "avx2", "sse2" or "scalar"
+    static const char* activeIsa() { return kernels().name; }
+
+    // Calls onToken(ptr, len) for every maximal run of bytes whose class is
+    // in tokenClasses, and onSymbol(c) for every OTHER byte that is not part
+    // of a token, in text order
+    template <typename OnToken, typename OnSymbol>
+    static void forEachToken(const char* text, size_t len, unsigned tokenClasses,
+                             OnToken onToken, OnSymbol onSymbol) {
+        const Kernels& k = kernels();
+        bool inToken = false;
+        size_t tokenStart = 0;
+
+        for (size_t base = 0; base < len; base += BLOCK) {
+            size_t n = len - base < BLOCK ? len - base : BLOCK;
+            ClassMasks m;
+            classifyBlock(k, text + base, n, m);
+
+            uint32_t valid = n == BLOCK ? 0xFFFFFFFFu : ((1u << n) - 1);
+            uint32_t token = select(m, tokenClasses) & valid;
+            uint32_t symbol = m.other & valid & ~token;
+
+            // Bit i is set where token membership differs from byte i - 1
+            uint32_t edges = (token ^ ((token << 1) | (inToken ? 1u : 0u))) & valid;
+            uint32_t events = edges | symbol;
+
+            while (events) {
+                unsigned i = lowestSetBit(events);
+                events &= events - 1;
+                size_t pos = base + i;
+
+                if ((edges >> i) & 1) {
+                    if (inToken) onToken(text + tokenStart, pos - tokenStart);
+                    else tokenStart = pos;
+                    inToken = !inToken;
+                }
+                if ((symbol >> i) & 1) onSymbol(text[pos]);
+            }
+        }
+
+        if (inToken) onToken(text + tokenStart, len - tokenStart);
+    }
+
+    template <typename OnToken>
+    static void forEachToken(const char* text, size_t len, unsigned tokenClasses, OnToken onToken) {
+        forEachToken(text, len, tokenClasses, onToken, [](char) {});
+    }
+
+    // Removes every byte whose class is not in keepClasses, compacting the
+    // text in place. Returns the new length.
+    static size_t keepClasses(char* text, size_t len, unsigned keepClasses) {
+        const Kernels& k = kernels();
+        size_t out = 0;
+
+        for (size_t base = 0; base < len; base += BLOCK) {
+            size_t n = len - base < BLOCK ? len - base : BLOCK;
+            ClassMasks m;
+            classifyBlock(k, text + base, n, m);
+
+            uint32_t valid = n == BLOCK ? 0xFFFFFFFFu : ((1u << n) - 1);
+            uint32_t keep = select(m, keepClasses) & valid;
+
+            if (keep == valid) {
+                // Whole block kept: one move, or nothing if nothing was dropped yet
+                if (out != base) memmove(text + out, text + base, n);
+                out += n;
+                continue;
+            }
+            while (keep) {
+                text[out++] = text[base + lowestSetBit(keep)];
+                keep &= keep - 1;
+            }
+        }
+        return out;
+    }
+
+    // ASCII lowercase of len bytes from src into dst; src == dst is allowed
+    static void toLower(const char* src, size_t len, char* dst) {
+        const Kernels& k = kernels();
+        size_t i = 0;
+        for (; i + BLOCK <= len; i += BLOCK) {
+            k.lower(src + i, dst + i);
+        }
+        for (; i < len; i++) {
+            unsigned char c = (unsigned char)src[i];
+            dst[i] = (char)((unsigned char)(c - 'A') < 26 ? c | 0x20 : c);
+        }
+    }
+
+private:
+    static const size_t BLOCK = 32;
+
+    struct ClassMasks {
+        uint32_t letter;
+        uint32_t digit;
+        uint32_t space;
+        uint32_t other;
+    };
+
+    struct Kernels {
+        void (*classify)(const char* block, ClassMasks& out);   // exactly BLOCK bytes
+        void (*lower)(const char* src, char* dst);              // exactly BLOCK bytes
+        const char* name;
+    };
+
+    static uint32_t select(const ClassMasks& m, unsigned classes) {
+        uint32_t mask = 0;
+        if (classes & LETTER) mask |= m.letter;
+        if (classes & DIGIT) mask |= m.digit;
+        if (classes & SPACE) mask |= m.space;
+        if (classes & OTHER) mask |= m.other;
+        return mask;
+    }
+
+    // Classifies n <= BLOCK bytes; a short tail is padded with zero bytes,
+    // whose bits the caller masks off
+    static void classifyBlock(const Kernels& k, const char* text, size_t n, ClassMasks& m) {
+        if (n == BLOCK) {
+            k.classify(text, m);
+        } else {
+            char padded[BLOCK] = {0};
+            memcpy(padded, text, n);
+            k.classify(padded, m);
+        }
+    }
+
+    // ---- Scalar kernels ----
+
+    static void classifyScalar(const char* block, ClassMasks& m) {
+        m.letter = m.digit = m.space = 0;
+        for (unsigned i = 0; i < BLOCK; i++) {
+            unsigned char c = (unsigned char)block[i];
+            uint32_t bit = 1u << i;
+            if ((unsigned char)((c | 0x20) - 'a') < 26) m.letter |= bit;
+            else if ((unsigned char)(c - '0') < 10) m.digit |= bit;
+            else if (c == ' ' || (unsigned char)(c - '\t') < 5) m.space |= bit;
+        }
+        m.other = ~(m.letter | m.digit | m.space);
+    }
+
+    static void lowerScalar(const char* src, char* dst) {
+        for (unsigned i = 0; i < BLOCK; i++) {
+            unsigned char c = (unsigned char)src[i];
+            dst[i] = (char)((unsigned char)(c - 'A') < 26 ? c | 0x20 : c);
+        }
+    }
+
+#if defined(CPU_X86)
+    // ---- SSE2 kernels (two 16-byte halves) ----
+
+    // Bytes in [low, low + count): shifting by 0x80 - low maps that range
+    // onto the bottom of the signed byte range, so one signed compare works
+    CPU_TARGET_SSE2
+    static __m128i inRange128(__m128i v, unsigned char low, unsigned char count) {
+        __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - low)));
+        return _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(0x80 + count)));
+    }
+
+    CPU_TARGET_SSE2
+    static void classifySse2(const char* block, ClassMasks& m) {
+        m.letter = m.digit = m.space = 0;
+        for (int half = 0; half < 2; half++) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(block + 16 * half));
+            __m128i folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+            __m128i letter = inRange128(folded, 'a', 26);
+            __m128i digit = inRange128(v, '0', 10);
+            __m128i space = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')), inRange128(v, '\t', 5));
+
+            int shift = 16 * half;
+            m.letter |= (uint32_t)_mm_movemask_epi8(letter) << shift;
+            m.digit |= (uint32_t)_mm_movemask_epi8(digit) << shift;
+            m.space |= (uint32_t)_mm_movemask_epi8(space) << shift;
+        }
+        m.other = ~(m.letter | m.digit | m.space);
+    }
+
+    CPU_TARGET_SSE2
+    static void lowerSse2(const char* src, char* dst) {
+        for (int half = 0; half < 2; half++) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(src + 16 * half));
+            __m128i upper = inRange128(v, 'A', 26);
+            v = _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+            _mm_storeu_si128((__m128i*)(dst + 16 * half), v);
+        }
+    }
+
+    // ---- AVX2 kernels (one 32-byte register) ----
+
+    CPU_TARGET_AVX2
+    static __m256i inRange256(__m256i v, unsigned char low, unsigned char count) {
+        __m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - low)));
+        return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + count)), shifted);
+    }
+
+    CPU_TARGET_AVX2
+    static void classifyAvx2(const char* block, ClassMasks& m) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)block);
+        __m256i folded = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        __m256i letter = inRange256(folded, 'a', 26);
+        __m256i digit = inRange256(v, '0', 10);
+        __m256i space = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')), inRange256(v, '\t', 5));
+
+        m.letter = (uint32_t)_mm256_movemask_epi8(letter);
+        m.digit = (uint32_t)_mm256_movemask_epi8(digit);
+        m.space = (uint32_t)_mm256_movemask_epi8(space);
+        m.other = ~(m.letter | m.digit | m.space);
+    }
+
+    CPU_TARGET_AVX2
+    static void lowerAvx2(const char* src, char* dst) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)src);
+        __m256i upper = inRange256(v, 'A', 26);
+        v = _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+        _mm256_storeu_si256((__m256i*)dst, v);
+    }
+#endif
+
+    static Kernels pickKernels() {
+#if defined(CPU_X86)
+        if (cpuHasAvx2()) return Kernels{classifyAvx2, lowerAvx2, "avx2"};
+        if (cpuHasSse2()) return Kernels{classifySse2, lowerSse2, "sse2"};
+#endif
+        return Kernels{classifyScalar, lowerScalar, "scalar"};
+    }
+
+    // Chosen once, on first use
+    static const Kernels& kernels() {
+        static const Kernels chosen = pickKernels();
+        return chosen;
+    }
+};
+
+// A token copied into a small inline buffer (or a string for long tokens),
+// filtered to some character classes and lowercased. Short tokens, which
+// is nearly all of them, never touch the heap.
+class TokenBuffer {
+private:
+    static const size_t INLINE_SIZE = 64;
+
+    char inlineChars[INLINE_SIZE];
+    std::string overflow;
+    char* chars;
+    size_t length;
+
+public:
+    TokenBuffer(const char* token, size_t len, unsigned keepClasses) {
+        if (len <= INLINE_SIZE) {
+            memcpy(inlineChars, token, len);
+            chars = inlineChars;
+        } else {
+            overflow.assign(token, len);
+            chars = &overflow[0];
+        }
+        length = Tokenizer::keepClasses(chars, len, keepClasses);
+        Tokenizer::toLower(chars, length, chars);
+    }
+
+    TokenBuffer(const TokenBuffer&) = delete;
+    TokenBuffer& operator=(const TokenBuffer&) = delete;
+
+    const char* data() const { return chars; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+};
+
+#endif // TOKENIZER_HPP
@@ -0,0 +1,279 @@
+#ifndef TRANSACTION_TABLE_HPP
+#define TRANSACTION_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include "stringInterner.hpp"
+#include "csvReader.hpp"
+#include "columnScan.hpp"
+
+// Growable array of plain values (numbers, pointers, codes). Elements are
+// copied with memcpy on growth and never constructed or destroyed.
+template <typename T>
+class PodColumn {
+private:
+    T* values;
+    size_t count;
+    size_t capacity;
+
+    void grow(size_t minCapacity) {
+        size_t newCapacity = capacity == 0 ? 16 : capacity * 2;
+        if (newCapacity < minCapacity) newCapacity = minCapacity;
+
+        T* newValues = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+        if (count > 0) memcpy(newValues, values, count * sizeof(T));
+        ::operator delete(values);
+        values = newValues;
+        capacity = newCapacity;
+    }
+
+public:
+    PodColumn() : values(nullptr), count(0), capacity(0) {}
+
+    ~PodColumn() {
+        ::operator delete(values);
+    }
+
+    PodColumn(const PodColumn&) = delete;
+    PodColumn& operator=(const PodColumn&) = delete;
+
+    PodColumn(PodColumn&& other) noexcept
+        : values(other.values), count(other.count), capacity(other.capacity) {
+        other.values = nullptr;
+        other.count = 0;
+        other.capacity = 0;
+    }
+
+    PodColumn& operator=(PodColumn&& other) noexcept {
+        if (this != &other) {
+            ::operator delete(values);
+            values = other.values;
+            count = other.count;
+            capacity = other.capacity;
+            other.values = nullptr;
+            other.count = 0;
+            other.capacity = 0;
+        }
+        return *this;
+    }
+
+    void reserve(size_t n) {
+        if (n > capacity) grow(n);
+    }
+
+    void push_back(T value) {
+        if (count == capacity) grow(count + 1);
+        values[count++] = value;
+    }
+
+    void clear() { count = 0; }
+
+    T operator[](size_t index) const { return values[index]; }
+    T& operator[](size_t index) { return values[index]; }
+
+    const T* data() const { return values; }
+    T* data() { return values; }
+    size_t size() const { return count; }
+};
+
+// Dictionary-encoded string column. Each distinct value is stored once in
+// a StringInterner and every row holds only its small integer code, so a
+// filter on the column becomes an integer compare per row. Code is the
+// narrowest unsigned type that fits the column's cardinality; appending a
+// value beyond its range throws std::overflow_error.
+template <typename Code>
+class DictionaryColumn {
+private:
+    StringInterner dictionary;
+    PodColumn<Code> codes;
+
+public:
+    void reserve(size_t n) { codes.reserve(n); }
+
+    // True if push_back(str, len) would not overflow: the value already
+    // has a code or there is a code left for it
+    bool canEncode(const char* str, size_t len) const {
+        if ((uint64_t)dictionary.size() <= (uint64_t)std::numeric_limits<Code>::max()) return true;
+        uint32_t id;
+        return dictionary.find(str, len, id);
+    }
+
+    // Checked before interning, so a value that overflows leaves the
+    // column unchanged
+    void push_back(const char* str, size_t len) {
+        if (!canEncode(str, len)) {
+            throw std::overflow_error("Too many distinct values for dictionary column");
+        }
+        codes.push_back((Code)dictionary.intern(str, len));
+    }
+
+    void clear() {
+        dictionary.clear();
+        codes.clear();
+    }
+
+    // Code of a value; false if no row has it
+    bool find(const char* str, size_t len, Code& code) const {
+        uint32_t id;
+        if (!dictionary.find(str, len, id)) return false;
+        code = (Code)id;
+        return true;
+    }
+
+    bool find(const char* str, Code& code) const { return find(str, strlen(str), code); }
+
+    Code code(size_t row) const { return codes[row]; }
+    const Code* codeData() const { return codes.data(); }
+
+    FieldView value(Code code) const { return FieldView(dictionary.key(code), dictionary.keyLength(code)); }
+    FieldView operator[](size_t row) const { return value(codes[row]); }
+
+    size_t distinctCount() const { return dictionary.size(); }
+    size_t size() const { return codes.size(); }
+};
+
+// Column-oriented (struct of arrays) transaction store. Each field is its
+// own contiguous column, so a scan reads only the columns it filters or
+// aggregates: a price total streams one array of doubles, and a category
+// filter never loads customer or product data. Rows are addressed by index
+// and appear in insertion order.
+//
+// The string fields are dictionary-encoded: a row is 20 bytes (customer id
+// 4, product 2, category 1, payment 1, price 8, date 4) and each distinct
+// string is stored once.
+class TransactionTable {
+public:
+    typedef uint32_t CustomerCode;   // Interned customer IDs
+    typedef uint16_t ProductCode;
+    typedef uint8_t CategoryCode;
+    typedef uint8_t PaymentCode;
+
+private:
+    DictionaryColumn<CustomerCode> customerIDs;
+    DictionaryColumn<ProductCode> products;
+    DictionaryColumn<CategoryCode> categories;
+    PodColumn<double> prices;
+    PodColumn<uint32_t> dateKeys;   // yyyymmdd, see dateKey.hpp
+    DictionaryColumn<PaymentCode> paymentMethods;
+
+public:
+    TransactionTable() {}
+
+    TransactionTable(const TransactionTable&) = delete;
+    TransactionTable& operator=(const TransactionTable&) = delete;
+
+    void reserve(size_t rows) {
+        customerIDs.reserve(rows);
+        products.reserve(rows);
+        categories.reserve(rows);
+        prices.reserve(rows);
+        dateKeys.reserve(rows);
+        paymentMethods.reserve(rows);
+    }
+
+    // Appends one row; new string values are added to the dictionaries.
+    // Every column is checked before any is written, so a value that
+    // overflows its dictionary throws std::overflow_error and leaves the
+    // table unchanged.
+    void append(const FieldView& customerID, const FieldView& product, const FieldView& category,
+                double price, uint32_t dateKey, const FieldView& paymentMethod) {
+        if (!customerIDs.canEncode(customerID.ptr, customerID.len) ||
+            !products.canEncode(product.ptr, product.len) ||
+            !categories.canEncode(category.ptr, category.len) ||
+            !paymentMethods.canEncode(paymentMethod.ptr, paymentMethod.len)) {
+            throw std::overflow_error("Too many distinct values for dictionary column");
+        }
+
+        customerIDs.push_back(customerID.ptr, customerID.len);
+        products.push_back(product.ptr, product.len);
+        categories.push_back(category.ptr, category.len);
+        prices.push_back(price);
+        dateKeys.push_back(dateKey);
+        paymentMethods.push_back(paymentMethod.ptr, paymentMethod.len);
+    }
+
+    void clear() {
+        customerIDs.clear();
+        products.clear();
+        categories.clear();
+        prices.clear();
+        dateKeys.clear();
+        paymentMethods.clear();
+    }
+
+    size_t size() const { return prices.size(); }
+    bool empty() const { return prices.size() == 0; }
+
+    // Whole columns, for scans that need direct access
+    const DictionaryColumn<CustomerCode>& customerIDColumn() const { return customerIDs; }
+    const DictionaryColumn<ProductCode>& productColumn() const { return products; }
+    const DictionaryColumn<CategoryCode>& categoryColumn() const { return categories; }
+    const PodColumn<double>& priceColumn() const { return prices; }
+    const PodColumn<uint32_t>& dateKeyColumn() const { return dateKeys; }
+    const DictionaryColumn<PaymentCode>& paymentMethodColumn() const { return paymentMethods; }
+
+    // Single fields of one row
+    FieldView customerID(size_t row) const { return customerIDs[row]; }
+    FieldView product(size_t row) const { return products[row]; }
+    FieldView category(size_t row) const { return categories[row]; }
+    double price(size_t row) const { return prices[row]; }
+    uint32_t dateKey(size_t row) const { return dateKeys[row]; }
+    FieldView paymentMethod(size_t row) const { return paymentMethods[row]; }
+
+    // ---- Scans ----
+
+    // Rows in category, and how many of those were paid with paymentMethod.
+    // The strings are looked up once; the scans are SIMD code compares.
+    void countCategoryPayment(const char* category, const char* paymentMethod,
+                              size_t& inCategory, size_t& withPayment) const {
+        inCategory = 0;
+        withPayment = 0;
+
+        CategoryCode categoryCode = 0;
+        PaymentCode paymentCode = 0;
+        if (!categories.find(category, categoryCode)) return;
+
+        CodeEquals terms[2] = {
+            {categories.codeData(), categoryCode},
+            {paymentMethods.codeData(), paymentCode}
+        };
+        inCategory = ColumnScan::countAll(terms, 1, size());
+        if (paymentMethods.find(paymentMethod, paymentCode)) {
+            terms[1].value = paymentCode;
+            withPayment = ColumnScan::countAll(terms, 2, size());
+        }
+    }
+
+    size_t countCategory(const char* category) const {
+        CategoryCode categoryCode = 0;
+        if (!categories.find(category, categoryCode)) return 0;
+        return ColumnScan::countEqual(categories.codeData(), size(), categoryCode);
+    }
+
+    size_t categoryCount() const { return categories.distinctCount(); }
+    size_t paymentMethodCount() const { return paymentMethods.distinctCount(); }
+    FieldView categoryName(CategoryCode code) const { return categories.value(code); }
+    FieldView paymentMethodName(PaymentCode code) const { return paymentMethods.value(code); }
+
+    // Row counts for every (category, payment method) pair in one pass:
+    // counts[categoryCode * paymentMethodCount() + paymentCode].
+    // counts must hold categoryCount() * paymentMethodCount() entries.
+    void crossTabCategoryPayment(size_t* counts) const {
+        ColumnScan::crossTab(categories.codeData(), categoryCount(),
+                             paymentMethods.codeData(), paymentMethodCount(), size(), counts);
+    }
+
+    // Sum of the price column
+    double totalPrice() const { return ColumnScan::sum(prices.data(), size()); }
+
+    // Rows dated within [fromKey, toKey], and their total price
+    size_t countInDateRange(uint32_t fromKey, uint32_t toKey, double* priceTotal = nullptr) const {
+        return ColumnScan::countInRange(dateKeys.data(), prices.data(), size(), fromKey, toKey, priceTotal);
+    }
+};
+
+#endif // TRANSACTION_TABLE_HPP
@@ -0,0 +1,325 @@
+#ifndef UNROLLED_LIST_HPP
+#define UNROLLED_LIST_HPP
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "nodePool.hpp"
+
+// Unrolled linked list: a singly linked chain of blocks, each holding up to
+// BLOCK_SIZE elements in a contiguous array. A walk reads BLOCK_SIZE
+// elements per pointer hop, so traversal runs close to array speed, while
+// splicing two lists is still a pointer swap and inserting in the middle
+// only shifts elements within one block.
+//
+// Blocks come from a NodePool; appended elements fill the tail block in
+// order. Blocks are never empty. Filtering can leave them part-full; sort()
+// packs them again.
+template <typename T, size_t BLOCK_SIZE = 64>
+class UnrolledList {
+    static_assert(BLOCK_SIZE >= 2, "Blocks must hold at least two elements");
+
+private:
+    struct Block {
+        Block* next;
+        size_t count;
+        alignas(T) unsigned char storage[BLOCK_SIZE * sizeof(T)];
+
+        Block() : next(nullptr), count(0) {}
+        T* items() { return reinterpret_cast<T*>(storage); }
+    };
+
+    // A sorted chain of blocks, used while sorting
+    struct Run {
+        Block* first;
+        Block* last;
+    };
+
+    static const size_t BLOCKS_PER_CHUNK = 16;
+
+    NodePool<Block> blocks;
+    Block* head;
+    Block* tail;
+    size_t total;
+
+    Block* newBlockAfter(Block* previous) {
+        Block* block = blocks.create();
+        if (previous) {
+            block->next = previous->next;
+            previous->next = block;
+        } else {
+            block->next = head;
+            head = block;
+        }
+        if (tail == previous) tail = block;
+        return block;
+    }
+
+    void destroyElements() {
+        for (Block* block = head; block; block = block->next) {
+            T* items = block->items();
+            for (size_t i = 0; i < block->count; i++) items[i].~T();
+        }
+    }
+
+    // Moves src into raw slot dst and ends src's lifetime
+    static void relocate(T* dst, T* src) {
+        new (dst) T(std::move(*src));
+        src->~T();
+    }
+
+    template <typename Less>
+    static void insertionSort(T* items, size_t count, Less& less) {
+        for (size_t i = 1; i < count; i++) {
+            if (!less(items[i], items[i - 1])) continue;
+
+            T key = std::move(items[i]);
+            size_t j = i;
+            while (j > 0 && less(key, items[j - 1])) {
+                items[j] = std::move(items[j - 1]);
+                j--;
+            }
+            items[j] = std::move(key);
+        }
+    }
+
+    // Merges two sorted runs into a new run of full blocks. Source blocks
+    // go back to the pool as soon as they are used up, so the merge needs
+    // about one spare block. Takes from left on ties, which keeps it stable.
+    template <typename Less>
+    Run mergeRuns(Run left, Run right, Less& less) {
+        Run out = {nullptr, nullptr};
+        Block* a = left.first;
+        Block* b = right.first;
+        size_t ai = 0, bi = 0;
+
+        while (a || b) {
+            Block*& from = (!b || (a && !less(b->items()[bi], a->items()[ai]))) ? a : b;
+            size_t& index = &from == &a ? ai : bi;
+
+            if (!out.last || out.last->count == BLOCK_SIZE) {
+                Block* block = blocks.create();
+                if (out.last) out.last->next = block;
+                else out.first = block;
+                out.last = block;
+            }
+            relocate(&out.last->items()[out.last->count++], &from->items()[index++]);
+
+            if (index == from->count) {
+                Block* used = from;
+                from = from->next;
+                index = 0;
+                blocks.destroy(used);
+            }
+        }
+        return out;
+    }
+
+public:
+    class iterator {
+    private:
+        friend class UnrolledList;
+        Block* block;
+        size_t index;
+
+        iterator(Block* b, size_t i) : block(b), index(i) {}
+
+    public:
+        T& operator*() const { return block->items()[index]; }
+        T* operator->() const { return &block->items()[index]; }
+
+        iterator& operator++() {
+            if (++index == block->count) {
+                block = block->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return block == other.block && index == other.index; }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+    };
+
+    UnrolledList() : blocks(BLOCKS_PER_CHUNK), head(nullptr), tail(nullptr), total(0) {}
+
+    ~UnrolledList() {
+        destroyElements();
+    }
+
+    UnrolledList(const UnrolledList&) = delete;
+    UnrolledList& operator=(const UnrolledList&) = delete;
+
+    UnrolledList(UnrolledList&& other) noexcept
+        : blocks(std::move(other.blocks)), head(other.head), tail(other.tail), total(other.total) {
+        other.head = other.tail = nullptr;
+        other.total = 0;
+    }
+
+    // Constructs a new element at the end and returns it
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (!tail || tail->count == BLOCK_SIZE) newBlockAfter(tail);
+        T* slot = &tail->items()[tail->count];
+        new (slot) T(std::forward<Args>(args)...);
+        tail->count++;
+        total++;
+        return *slot;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    // Inserts value before pos and returns its position. A full block is
+    // split in two first, so at most BLOCK_SIZE / 2 elements are shifted.
+    iterator insert(iterator pos, T value) {
+        if (pos == end()) {
+            emplace_back(std::move(value));
+            return iterator(tail, tail->count - 1);
+        }
+
+        Block* block = pos.block;
+        size_t index = pos.index;
+        if (block->count == BLOCK_SIZE) {
+            const size_t half = BLOCK_SIZE / 2;
+            Block* upper = newBlockAfter(block);
+            for (size_t i = half; i < BLOCK_SIZE; i++) {
+                relocate(&upper->items()[i - half], &block->items()[i]);
+            }
+            upper->count = BLOCK_SIZE - half;
+            block->count = half;
+            if (index >= half) {
+                block = upper;
+                index -= half;
+            }
+        }
+
+        T* items = block->items();
+        for (size_t i = block->count; i > index; i--) relocate(&items[i], &items[i - 1]);
+        new (&items[index]) T(std::move(value));
+        block->count++;
+        total++;
+        return iterator(block, index);
+    }
+
+    // Removes every element for which remove(element) is true, keeping the
+    // order of the rest. Returns the number removed.
+    template <typename Predicate>
+    size_t removeIf(Predicate remove) {
+        size_t removed = 0;
+        Block* previous = nullptr;
+        Block* block = head;
+
+        while (block) {
+            T* items = block->items();
+            size_t kept = 0;
+            for (size_t i = 0; i < block->count; i++) {
+                if (remove(items[i])) {
+                    items[i].~T();
+                    removed++;
+                } else {
+                    if (kept != i) relocate(&items[kept], &items[i]);
+                    kept++;
+                }
+            }
+            block->count = kept;
+
+            Block* next = block->next;
+            if (kept == 0) {
+                if (previous) previous->next = next;
+                else head = next;
+                if (tail == block) tail = previous;
+                blocks.destroy(block);
+            } else {
+                previous = block;
+            }
+            block = next;
+        }
+
+        total -= removed;
+        return removed;
+    }
+
+    // Elements for which match(element) is true
+    template <typename Predicate>
+    size_t count(Predicate match) const {
+        size_t matches = 0;
+        for (const Block* block = head; block; block = block->next) {
+            const T* items = const_cast<Block*>(block)->items();
+            for (size_t i = 0; i < block->count; i++) matches += match(items[i]) ? 1 : 0;
+        }
+        return matches;
+    }
+
+    // Calls visit(items, count) once per block, in order; the fastest way
+    // to scan the list
+    template <typename Visit>
+    void forEachBlock(Visit visit) const {
+        for (const Block* block = head; block; block = block->next) {
+            visit((const T*)const_cast<Block*>(block)->items(), block->count);
+        }
+    }
+
+    // Stable sort by less(a, b). Each block is insertion-sorted, then block
+    // runs are merged bottom-up with the same binary-counter bins as the
+    // linked list merge sort. The result is packed into full blocks.
+    template <typename Less>
+    void sort(Less less) {
+        if (total < 2) return;
+
+        const int MAX_BINS = 64;
+        Run bins[MAX_BINS] = {};
+
+        Block* block = head;
+        while (block) {
+            Block* next = block->next;
+            block->next = nullptr;
+            insertionSort(block->items(), block->count, less);
+
+            Run run = {block, block};
+            int i = 0;
+            for (; i < MAX_BINS - 1 && bins[i].first; i++) {
+                run = mergeRuns(bins[i], run, less);
+                bins[i].first = nullptr;
+            }
+            bins[i] = run;
+            block = next;
+        }
+
+        // Lower bins hold newer runs, so each bin goes on the left
+        Run result = {nullptr, nullptr};
+        for (int i = 0; i < MAX_BINS; i++) {
+            if (!bins[i].first) continue;
+            result = result.first ? mergeRuns(bins[i], result, less) : bins[i];
+        }
+        head = result.first;
+        tail = result.last;
+    }
+
+    // Moves every element of other onto the end of this list in O(1);
+    // other is left empty
+    void splice(UnrolledList& other) {
+        if (&other == this || !other.head) return;
+        blocks.absorb(other.blocks);
+        if (tail) tail->next = other.head;
+        else head = other.head;
+        tail = other.tail;
+        total += other.total;
+        other.head = other.tail = nullptr;
+        other.total = 0;
+    }
+
+    void clear() {
+        destroyElements();
+        blocks.clear();
+        head = tail = nullptr;
+        total = 0;
+    }
+
+    iterator begin() { return iterator(head, 0); }
+    iterator end() { return iterator(nullptr, 0); }
+
+    size_t size() const { return total; }
+    bool empty() const { return total == 0; }
+};
+
+#endif // UNROLLED_LIST_HPP
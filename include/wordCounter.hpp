@@ -0,0 +1,100 @@
+#ifndef WORD_COUNTER_HPP
+#define WORD_COUNTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "stringInterner.hpp"
+#include "daryHeap.hpp"
+
+// Word frequency table: a StringInterner gives each distinct word a dense
+// id and the count lives in a flat array indexed by that id. Counting a
+// token is one hash probe, so analysis is linear in the input size.
+class WordCounter {
+private:
+    StringInterner words;
+    std::vector<uint32_t> counts;
+
+    // Ranks a over b: higher count first, then alphabetical, so results do
+    // not depend on the order words were first seen
+    struct RankAbove {
+        const WordCounter* owner;
+
+        bool operator()(uint32_t a, uint32_t b) const {
+            if (owner->counts[a] != owner->counts[b]) return owner->counts[a] > owner->counts[b];
+            size_t lengthA = owner->words.keyLength(a);
+            size_t lengthB = owner->words.keyLength(b);
+            int order = memcmp(owner->words.key(a), owner->words.key(b),
+                               lengthA < lengthB ? lengthA : lengthB);
+            if (order != 0) return order < 0;
+            return lengthA < lengthB;
+        }
+    };
+
+public:
+    WordCounter() {}
+
+    WordCounter(const WordCounter&) = delete;
+    WordCounter& operator=(const WordCounter&) = delete;
+
+    void add(const char* word, size_t len, uint32_t times = 1) {
+        uint32_t id = words.intern(word, len);
+        if (id == counts.size()) counts.push_back(0);
+        counts[id] += times;
+    }
+
+    void add(const char* word, uint32_t times = 1) {
+        add(word, strlen(word), times);
+    }
+
+    // Adds every count of other into this table
+    void merge(const WordCounter& other) {
+        for (size_t id = 0; id < other.size(); id++) {
+            add(other.word((uint32_t)id), other.wordLength((uint32_t)id), other.counts[id]);
+        }
+    }
+
+    uint32_t count(const char* word, size_t len) const {
+        uint32_t id;
+        return words.find(word, len, id) ? counts[id] : 0;
+    }
+
+    // Distinct words, addressed by id 0 .. size() - 1
+    size_t size() const { return counts.size(); }
+    const char* word(uint32_t id) const { return words.key(id); }
+    size_t wordLength(uint32_t id) const { return words.keyLength(id); }
+    uint32_t frequency(uint32_t id) const { return counts[id]; }
+
+    // Writes the ids of the n most frequent words to outIds, most frequent
+    // first (ties alphabetical). Keeps only n candidates in a heap.
+    size_t topN(size_t n, uint32_t* outIds) const {
+        if (n == 0) return 0;
+
+        RankAbove rankAbove = {this};
+        // With "less" meaning "ranks above", the weakest candidate is on top
+        DaryHeap<uint32_t, RankAbove> heap(rankAbove);
+        heap.reserve(n < size() ? n : size());
+
+        for (uint32_t id = 0; id < size(); id++) {
+            if (heap.getSize() < n) {
+                heap.insert(id);
+            } else if (rankAbove(id, heap.top())) {
+                heap.replaceTop(id);
+            }
+        }
+
+        size_t found = heap.getSize();
+        for (size_t i = found; i > 0; i--) {
+            outIds[i - 1] = heap.extractMax();
+        }
+        return found;
+    }
+
+    void clear() {
+        words.clear();
+        counts.clear();
+    }
+};
+
+#endif // WORD_COUNTER_HPP
@@ -5,23 +5,17 @@ using namespace std;
 // Node constructor
 TransactionNode::TransactionNode(Transaction t) : data(t), next(nullptr) {}
 
-TransactionLinkedListStore::TransactionLinkedListStore() : head(nullptr), size(0) {}
-
-int TransactionLinkedListStore::convertDateToInt(const string& dateStr) {
-    int day = stoi(dateStr.substr(0, 2));
-    int month = stoi(dateStr.substr(3, 2));
-    int year = stoi(dateStr.substr(6, 4));
-    return year * 10000 + month * 100 + day;
-}
+TransactionLinkedListStore::TransactionLinkedListStore() : head(nullptr), tail(nullptr), size(0) {}
 
 void TransactionLinkedListStore::sortedInsertByDate(TransactionNode*& sortedHead, TransactionNode* newNode) {
-    int newDate = convertDateToInt(newNode->data.date);
-    if (!sortedHead || convertDateToInt(sortedHead->data.date) > newDate) {
+    // Compares the precomputed yyyymmdd keys instead of re-parsing the dates
+    uint32_t newDate = newNode->data.dateKey;
+    if (!sortedHead || sortedHead->data.dateKey > newDate) {
         newNode->next = sortedHead;
         sortedHead = newNode;
     } else {
         TransactionNode* current = sortedHead;
-        while (current->next && convertDateToInt(current->next->data.date) <= newDate) {
+        while (current->next && current->next->data.dateKey <= newDate) {
             current = current->next;
         }
         newNode->next = current->next;
@@ -30,14 +24,29 @@ void TransactionLinkedListStore::sortedInsertByDate(TransactionNode*& sortedHead
 }
 
 void TransactionLinkedListStore::insert(const Transaction& t) {
-    TransactionNode* newNode = new TransactionNode(t);
-    if (!head) head = newNode;
-    else {
-        TransactionNode* temp = head;
-        while (temp->next) temp = temp->next;
-        temp->next = newNode;
-    }
-    size++;
+    TransactionNode* newNode = createNode(t);
+    appendChain(newNode, newNode, 1);
+}
+
+TransactionNode* TransactionLinkedListStore::createNode(const Transaction& t) {
+    return nodes.create(t);
+}
+
+void TransactionLinkedListStore::appendChain(TransactionNode* first, TransactionNode* last, int count) {
+    if (!first) return;
+    last->next = nullptr;
+    if (!head) head = first;
+    else tail->next = first;
+    tail = last;
+    size += count;
+}
+
+void TransactionLinkedListStore::splice(TransactionLinkedListStore& other) {
+    if (&other == this) return;
+    nodes.absorb(other.nodes);
+    appendChain(other.head, other.tail, other.size);
+    other.head = other.tail = nullptr;
+    other.size = 0;
 }
 
 void TransactionLinkedListStore::insertionSortByDate() {
@@ -50,6 +59,8 @@ void TransactionLinkedListStore::insertionSortByDate() {
         current = next;
     }
     head = sorted;
+    tail = head;
+    while (tail->next) tail = tail->next;
 }
 
 void TransactionLinkedListStore::displayTransactions(int limit) const {
@@ -71,9 +82,5 @@ TransactionNode* TransactionLinkedListStore::getHead() const { return head; }
 int TransactionLinkedListStore::getSize() const { return size; }
 
 TransactionLinkedListStore::~TransactionLinkedListStore() {
-    while (head) {
-        TransactionNode* temp = head;
-        head = head->next;
-        delete temp;
-    }
+    // The pool destroys every node and frees its chunks
 }
@@ -5,17 +5,32 @@
 
 ReviewNode::ReviewNode(Review r) : data(r), next(nullptr) {}
 
-ReviewLinkedListStore::ReviewLinkedListStore() : head(nullptr), size(0) {}
+ReviewLinkedListStore::ReviewLinkedListStore() : head(nullptr), tail(nullptr), size(0) {}
 
 void ReviewLinkedListStore::insert(const Review& r) {
-    ReviewNode* newNode = new ReviewNode(r);
-    if (!head) head = newNode;
-    else {
-        ReviewNode* temp = head;
-        while (temp->next) temp = temp->next;
-        temp->next = newNode;
-    }
-    size++;
+    ReviewNode* newNode = createNode(r);
+    appendChain(newNode, newNode, 1);
+}
+
+ReviewNode* ReviewLinkedListStore::createNode(const Review& r) {
+    return nodes.create(r);
+}
+
+void ReviewLinkedListStore::appendChain(ReviewNode* first, ReviewNode* last, int count) {
+    if (!first) return;
+    last->next = nullptr;
+    if (!head) head = first;
+    else tail->next = first;
+    tail = last;
+    size += count;
+}
+
+void ReviewLinkedListStore::splice(ReviewLinkedListStore& other) {
+    if (&other == this) return;
+    nodes.absorb(other.nodes);
+    appendChain(other.head, other.tail, other.size);
+    other.head = other.tail = nullptr;
+    other.size = 0;
 }
 
 ReviewNode* ReviewLinkedListStore::getHead() const { return head; }
@@ -33,9 +48,5 @@ void ReviewLinkedListStore::displayReviews() {
 }
 
 ReviewLinkedListStore::~ReviewLinkedListStore() {
-    while (head) {
-        ReviewNode* temp = head;
-        head = head->next;
-        delete temp;
-    }
+    // The pool destroys every node and frees its chunks
 }
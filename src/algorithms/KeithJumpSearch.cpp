@@ -21,6 +21,7 @@ class KeithJumpSearch {
 private:
     Node* readCSV(const string& filename, int columnIndex) {
         Node* head = nullptr;
+        Node* tail = nullptr;   // Last node, so each append is O(1)
         ifstream file(filename);
         
         if (!file.is_open()) {
@@ -48,12 +49,9 @@ private:
                         if (head == nullptr) {
                             head = newNode;
                         } else {
-                            Node* temp = head;
-                            while (temp->next != nullptr) {
-                                temp = temp->next;
-                            }
-                            temp->next = newNode;
+                            tail->next = newNode;
                         }
+                        tail = newNode;
                     } catch (...) {
                         cerr << "Warning: Could not convert value '" << value << "' to number" << endl;
                     }
@@ -85,19 +83,24 @@ private:
 
 public:
     int jumpSearch(double arr[], int n, double x) {
-        int step = sqrt(n);
+        if (n <= 0)
+            return -1;
+
+        // Block size is computed once, not on every jump
+        const int step = max(1, (int)sqrt((double)n));
         int prev = 0;
-        
-        while (arr[min(step, n) - 1] < x) {
-            prev = step;
-            step += sqrt(n);
+        int next = step;
+
+        while (arr[min(next, n) - 1] < x) {
+            prev = next;
             if (prev >= n)
                 return -1;
+            next += step;
         }
         
         while (arr[prev] < x) {
             prev++;
-            if (prev == min(step, n))
+            if (prev == min(next, n))
                 return -1;
         }
         
@@ -1,35 +1,64 @@
 #include "../../include/SortingAlgorithms.hpp"
 #include "../../include/linkedList.hpp"
+#include <utility>
+#include <thread>
+#include <vector>
 
-// Linked List Merge Sort Implementation
+// Linked List Merge Sort Implementation (bottom-up)
+// Nodes are taken off the list one at a time and merged into bins, where
+// bins[i] holds a sorted run of 2^i nodes, like incrementing a binary
+// counter. No recursion and O(1) extra space (one pointer per bit of n).
+// Recently built runs are merged while still in cache. Older runs are always
+// the left side of a merge, so equal dates keep their input order.
 void SortingAlgorithms::mergeSortLL(TransactionNode*& head) {
     if (!head || !head->next) return;
 
-    TransactionNode* left;
-    TransactionNode* right;
+    const int MAX_BINS = 64;
+    TransactionNode* bins[MAX_BINS] = {};
 
-    split(head, left, right);
+    while (head) {
+        TransactionNode* run = head;
+        head = head->next;
+        run->next = nullptr;
 
-    mergeSortLL(left);
-    mergeSortLL(right);
+        int i = 0;
+        for (; i < MAX_BINS - 1 && bins[i]; i++) {
+            run = merge(bins[i], run);
+            bins[i] = nullptr;
+        }
+        bins[i] = run;
+    }
 
-    head = merge(left, right);
+    // Lower bins hold newer nodes, so each bin goes on the left
+    for (int i = 0; i < MAX_BINS; i++) {
+        if (bins[i]) head = merge(bins[i], head);
+    }
 }
 
+// Iterative merge of two sorted lists (no recursion per node)
 TransactionNode* SortingAlgorithms::merge(TransactionNode* left, TransactionNode* right) {
-    if (!left) return right;
-    if (!right) return left;
-
     TransactionNode* result = nullptr;
+    TransactionNode* last = nullptr;
 
-    if (left->date <= right->date) {
-        result = left;
-        result->next = merge(left->next, right);
-    } else {
-        result = right;
-        result->next = merge(left, right->next);
+    while (left && right) {
+        TransactionNode* next;
+        if (left->dateKey <= right->dateKey) {
+            next = left;
+            left = left->next;
+        } else {
+            next = right;
+            right = right->next;
+        }
+
+        if (last) last->next = next;
+        else result = next;
+        last = next;
     }
 
+    // Attach whichever list is left over
+    TransactionNode* rest = left ? left : right;
+    if (last) last->next = rest;
+    else result = rest;
     return result;
 }
 
@@ -53,56 +82,190 @@ void SortingAlgorithms::split(TransactionNode* source, TransactionNode*& left, T
     slow->next = nullptr;
 }
 
-// Array Merge Sort Implementation
+// Both sorts order by the precomputed dateKey (yyyymmdd), so each comparison
+// is one integer compare and the order is chronological.
+
+// Array Merge Sort Implementation (bottom-up, one scratch buffer)
+// Runs of INSERTION_RUN elements are insertion-sorted in place, then merge
+// passes move elements between the array and a single scratch buffer,
+// swapping source and destination after each pass. The scratch buffer is
+// the only allocation and elements are moved, never copied.
 void SortingAlgorithms::mergeSortArray(TransactionArray& transactions) {
-    if (transactions.size() <= 1) return;
-    mergeSortArrayRecursive(transactions.getDataPtr(), 0, transactions.size() - 1);
+    size_t n = transactions.size();
+    if (n <= 1) return;
+
+    TransactionData* arr = transactions.getDataPtr();
+    if (n <= INSERTION_RUN) {
+        insertionSortRange(arr, 0, n);
+        return;
+    }
+
+    TransactionData* scratch = new TransactionData[n];
+    sortRange(arr, scratch, 0, n);
+    delete[] scratch;
+}
+
+// Sorts arr[begin, end) using scratch[begin, end) as the merge buffer.
+// The sorted result always ends up back in arr.
+void SortingAlgorithms::sortRange(TransactionData* arr, TransactionData* scratch, size_t begin, size_t end) {
+    for (size_t runBegin = begin; runBegin < end; runBegin += INSERTION_RUN) {
+        size_t runEnd = runBegin + INSERTION_RUN < end ? runBegin + INSERTION_RUN : end;
+        insertionSortRange(arr, runBegin, runEnd);
+    }
+
+    TransactionData* src = arr;
+    TransactionData* dst = scratch;
+    size_t n = end - begin;
+
+    for (size_t width = INSERTION_RUN; width < n; width *= 2) {
+        for (size_t left = begin; left < end; left += 2 * width) {
+            size_t mid = width < end - left ? left + width : end;
+            size_t right = width < end - mid ? mid + width : end;
+            mergeRuns(src, left, mid, right, dst);
+        }
+        TransactionData* temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    // An odd number of passes leaves the result in the scratch buffer
+    if (src != arr) {
+        for (size_t i = begin; i < end; i++) arr[i] = std::move(src[i]);
+    }
 }
 
-void SortingAlgorithms::mergeSortArrayRecursive(TransactionData* arr, size_t left, size_t right) {
-    if (left >= right) return;
-    size_t mid = left + (right - left) / 2;
-    mergeSortArrayRecursive(arr, left, mid);
-    mergeSortArrayRecursive(arr, mid + 1, right);
-    mergeArrays(arr, left, mid, right);
+// Stable insertion sort of arr[begin, end) by date
+void SortingAlgorithms::insertionSortRange(TransactionData* arr, size_t begin, size_t end) {
+    for (size_t i = begin + 1; i < end; i++) {
+        if (arr[i - 1].dateKey <= arr[i].dateKey) continue;
+
+        TransactionData key = std::move(arr[i]);
+        size_t j = i;
+        while (j > begin && arr[j - 1].dateKey > key.dateKey) {
+            arr[j] = std::move(arr[j - 1]);
+            j--;
+        }
+        arr[j] = std::move(key);
+    }
 }
 
-void SortingAlgorithms::mergeArrays(TransactionData* arr, size_t left, size_t mid, size_t right) {
-    size_t n1 = mid - left + 1;
-    size_t n2 = right - mid;
+// Moves the merge of src[left, mid) and src[mid, right) into dst[left, right)
+void SortingAlgorithms::mergeRuns(TransactionData* src, size_t left, size_t mid, size_t right,
+                                  TransactionData* dst) {
+    mergeSpans(src, left, mid, mid, right, dst, left);
+}
 
-    TransactionData* L = new TransactionData[n1];
-    TransactionData* R = new TransactionData[n2];
+// Moves the merge of src[a, aEnd) and src[b, bEnd) into dst starting at out.
+// Takes from the first span on equal keys, which keeps merges stable.
+void SortingAlgorithms::mergeSpans(TransactionData* src, size_t a, size_t aEnd, size_t b, size_t bEnd,
+                                   TransactionData* dst, size_t out) {
+    while (a < aEnd && b < bEnd) {
+        if (src[a].dateKey <= src[b].dateKey) {
+            dst[out++] = std::move(src[a++]);
+        } else {
+            dst[out++] = std::move(src[b++]);
+        }
+    }
+    while (a < aEnd) dst[out++] = std::move(src[a++]);
+    while (b < bEnd) dst[out++] = std::move(src[b++]);
+}
 
-    for (size_t i = 0; i < n1; i++)
-        L[i] = arr[left + i];
-    for (size_t j = 0; j < n2; j++)
-        R[j] = arr[mid + 1 + j];
+// Number of elements of src[left, mid) among the first k outputs of a stable
+// merge of src[left, mid) and src[mid, right) (the "merge path" split).
+// Lets one merge be cut into independent pieces for several threads.
+size_t SortingAlgorithms::mergeSplit(const TransactionData* src, size_t left, size_t mid, size_t right, size_t k) {
+    size_t leftLength = mid - left;
+    size_t rightLength = right - mid;
+    size_t low = k > rightLength ? k - rightLength : 0;
+    size_t high = k < leftLength ? k : leftLength;
 
-    size_t i = 0, j = 0, k = left;
-    while (i < n1 && j < n2) {
-        if (L[i].date <= R[j].date) {
-            arr[k] = L[i];
-            i++;
+    while (low < high) {
+        size_t takeLeft = low + (high - low) / 2;
+        size_t takeRight = k - takeLeft;
+        // Left element takeLeft comes out before right element takeRight - 1
+        if (src[left + takeLeft].dateKey <= src[mid + takeRight - 1].dateKey) {
+            low = takeLeft + 1;
         } else {
-            arr[k] = R[j];
-            j++;
+            high = takeLeft;
         }
-        k++;
     }
+    return low;
+}
 
-    while (i < n1) {
-        arr[k] = L[i];
-        i++;
-        k++;
+// Runs task(0) .. task(count - 1) on separate threads; task 0 on the caller
+template <typename Task>
+static void runTasks(size_t count, Task task) {
+    std::vector<std::thread> threads;
+    threads.reserve(count > 0 ? count - 1 : 0);
+    for (size_t i = 1; i < count; i++) {
+        threads.emplace_back([&task, i]() { task(i); });
     }
+    if (count > 0) task(0);
+    for (size_t i = 0; i < threads.size(); i++) threads[i].join();
+}
 
-    while (j < n2) {
-        arr[k] = R[j];
-        j++;
-        k++;
+// Parallel Array Merge Sort
+// The array is cut into one block per thread and each block is sorted with
+// sortRange. Sorted blocks are then merged pairwise, round by round, between
+// the array and the scratch buffer. Every merge of a round is split into
+// pieces at merge-path positions so all threads stay busy until the last
+// round. Same order as mergeSortArray (stable on dateKey).
+void SortingAlgorithms::parallelMergeSortArray(TransactionArray& transactions, unsigned threads) {
+    size_t n = transactions.size();
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads <= 1 || n < PARALLEL_THRESHOLD) {
+        mergeSortArray(transactions);
+        return;
     }
 
-    delete[] L;
-    delete[] R;
-} 
\ No newline at end of file
+    TransactionData* arr = transactions.getDataPtr();
+    TransactionData* scratch = new TransactionData[n];
+
+    // Phase 1: sort one block per thread
+    size_t blocks = threads;
+    size_t blockSize = (n + blocks - 1) / blocks;
+    runTasks(blocks, [&](size_t block) {
+        size_t begin = block * blockSize < n ? block * blockSize : n;
+        size_t end = begin + blockSize < n ? begin + blockSize : n;
+        if (begin < end) sortRange(arr, scratch, begin, end);
+    });
+
+    // Phase 2: merge rounds, doubling the run width each time
+    TransactionData* src = arr;
+    TransactionData* dst = scratch;
+    for (size_t width = blockSize; width < n; width *= 2) {
+        size_t pairs = (n + 2 * width - 1) / (2 * width);
+        size_t piecesPerPair = threads / pairs > 0 ? threads / pairs : 1;
+
+        runTasks(pairs * piecesPerPair, [&](size_t task) {
+            size_t left = (task / piecesPerPair) * 2 * width;
+            size_t piece = task % piecesPerPair;
+            size_t mid = width < n - left ? left + width : n;
+            size_t right = width < n - mid ? mid + width : n;
+
+            // Output positions [outBegin, outEnd) of this pair belong to this piece
+            size_t total = right - left;
+            size_t outBegin = total * piece / piecesPerPair;
+            size_t outEnd = total * (piece + 1) / piecesPerPair;
+            size_t aBegin = mergeSplit(src, left, mid, right, outBegin);
+            size_t aEnd = mergeSplit(src, left, mid, right, outEnd);
+
+            mergeSpans(src, left + aBegin, left + aEnd,
+                       mid + (outBegin - aBegin), mid + (outEnd - aEnd),
+                       dst, left + outBegin);
+        });
+
+        TransactionData* temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    if (src != arr) {
+        runTasks(threads, [&](size_t part) {
+            size_t begin = n * part / threads;
+            size_t end = n * (part + 1) / threads;
+            for (size_t i = begin; i < end; i++) arr[i] = std::move(src[i]);
+        });
+    }
+    delete[] scratch;
+}
@@ -6,178 +6,76 @@
 #include <iomanip>
 #include <cmath>
 
-// HeapLinkedList implementation
-HeapLinkedList::HeapLinkedList() : root(nullptr), last(nullptr), size(0) {}
-
-HeapLinkedList::~HeapLinkedList() {
-    // Delete nodes level by level
-    while (root) {
-        HeapNode* current = root;
-        root = nullptr;
-        
-        // Delete current level
-        while (current) {
-            HeapNode* next = current->next;
-            delete current;
-            current = next;
-        }
-    }
-    last = nullptr;
-    size = 0;
-}
-
-void HeapLinkedList::heapifyUp(HeapNode* node) {
-    while (node && node->parent && node->data > node->parent->data) {
-        swapValues(node, node->parent);
-        node = node->parent;
+// Candidate kept by the top-K heap: the item (row number or node), its
+// price and its position in the input for deterministic tie-breaking
+template <typename Item>
+struct PriceCandidate {
+    double price;
+    size_t row;
+    Item item;
+};
+
+// Orders candidates so the weakest one is on top of the heap: a is "less"
+// than b when a is the better result (higher price, or earlier on ties)
+template <typename Item>
+struct WeakestOnTop {
+    bool operator()(const PriceCandidate<Item>& a, const PriceCandidate<Item>& b) const {
+        if (a.price != b.price) return a.price > b.price;
+        return a.row < b.row;
     }
-}
-
-void HeapLinkedList::heapifyDown(HeapNode* node) {
-    while (true) {
-        HeapNode* largest = node;
-        HeapNode* left = node->left;
-        HeapNode* right = node->right;
-
-        if (left && left->data > largest->data)
-            largest = left;
-        if (right && right->data > largest->data)
-            largest = right;
-
-        if (largest != node) {
-            swapValues(node, largest);
-            node = largest;
-        } else {
-            break;
+};
+
+// Streams items through a heap of at most k candidates, then writes the
+// winners to out, best first. nextItem(price, item) returns false at the end.
+// itemCount is the number of items when known, so the heap is allocated
+// once at min(k, itemCount); 0 means unknown and the heap grows as needed.
+template <typename Item, typename NextItem>
+static size_t selectTopK(size_t k, NextItem nextItem, Item* out, size_t itemCount) {
+    if (k == 0) return 0;
+
+    DaryHeap<PriceCandidate<Item>, WeakestOnTop<Item> > heap;
+    if (itemCount > 0) heap.reserve(k < itemCount ? k : itemCount);
+    WeakestOnTop<Item> better;
+
+    PriceCandidate<Item> candidate;
+    candidate.row = 0;
+    while (nextItem(candidate.price, candidate.item)) {
+        if (heap.getSize() < k) {
+            heap.insert(candidate);
+        } else if (better(candidate, heap.top())) {
+            heap.replaceTop(candidate);
         }
+        candidate.row++;
     }
-}
 
-void HeapLinkedList::swapValues(HeapNode* a, HeapNode* b) {
-    double temp = a->data;
-    a->data = b->data;
-    b->data = temp;
-}
-
-HeapNode* HeapLinkedList::getParent(HeapNode* node) {
-    return node->parent;
-}
-
-HeapNode* HeapLinkedList::getLastParent() {
-    if (!last) return nullptr;
-    return last->parent;
-}
-
-void HeapLinkedList::insert(double value) {
-    HeapNode* newNode = new HeapNode(value);
-    size++;
-
-    if (!root) {
-        root = last = newNode;
-        return;
-    }
-
-    // Find position for new node using integer division
-    int lastPos = size - 1;
-    HeapNode* current = root;
-    int height = 0;
-    int temp = lastPos;
-    while (temp > 0) {
-        temp /= 2;
-        height++;
-    }
-
-    // Navigate to parent of new node
-    for (int i = 0; i < height && current; i++) {
-        int bitPosition = height - 1 - i;
-        bool goRight = (lastPos >> bitPosition) & 1;
-        
-        if (goRight && current->right)
-            current = current->right;
-        else if (!goRight && current->left)
-            current = current->left;
-        else
-            break;
+    // The heap pops the weakest first, so fill the output from the back
+    size_t found = heap.getSize();
+    for (size_t i = found; i > 0; i--) {
+        out[i - 1] = heap.extractMax().item;
     }
-
-    // Add new node
-    if (!current->left)
-        current->left = newNode;
-    else
-        current->right = newNode;
-
-    newNode->parent = current;
-    last = newNode;
-
-    heapifyUp(newNode);
+    return found;
 }
 
-double HeapLinkedList::extractMax() {
-    if (!root) throw std::runtime_error("Heap is empty");
-
-    double maxVal = root->data;
-    
-    if (size == 1) {
-        delete root;
-        root = last = nullptr;
-        size = 0;
-        return maxVal;
-    }
-
-    // Replace root with last node
-    root->data = last->data;
-
-    // Remove last node
-    HeapNode* oldLast = last;
-    HeapNode* parent = last->parent;
-    if (parent) {
-        if (parent->right == last)
-            parent->right = nullptr;
-        else
-            parent->left = nullptr;
-    }
-
-    // Update last pointer using integer division
-    if (size > 2) {
-        int newLastPos = size - 2;
-        HeapNode* current = root;
-        
-        int height = 0;
-        int temp = newLastPos;
-        while (temp > 0) {
-            temp /= 2;
-            height++;
-        }
-
-        // Navigate to new last node
-        for (int i = 0; i < height && current; i++) {
-            int bitPosition = height - 1 - i;
-            bool goRight = (newLastPos >> bitPosition) & 1;
-            
-            if (goRight && current->right)
-                current = current->right;
-            else if (!goRight && current->left)
-                current = current->left;
-            else
-                break;
-        }
-        last = current;
-    } else {
-        last = root;
-    }
-
-    delete oldLast;
-    size--;
-
-    // Maintain heap property
-    heapifyDown(root);
-
-    return maxVal;
+size_t HeapSort::topKByPrice(const TransactionArray& transactions, size_t k, size_t* outRows) {
+    size_t index = 0;
+    return selectTopK(k, [&](double& price, size_t& row) {
+        if (index >= transactions.size()) return false;
+        price = transactions[index].price;
+        row = index++;
+        return true;
+    }, outRows, transactions.size());
 }
 
-HeapNode* HeapLinkedList::getRoot() const { return root; }
-int HeapLinkedList::getSize() const { return size; }
-bool HeapLinkedList::isEmpty() const { return size == 0; }
+size_t HeapSort::topKByPrice(TransactionNode* head, size_t k, TransactionNode** outNodes) {
+    TransactionNode* current = head;
+    return selectTopK(k, [&](double& price, TransactionNode*& node) {
+        if (!current) return false;
+        price = current->price;
+        node = current;
+        current = current->next;
+        return true;
+    }, outNodes, 0);
+}
 
 // HeapSort implementation
 void HeapSort::sortTransactions(TransactionNode*& head) {
@@ -0,0 +1,182 @@
+#include "../../include/radixSort.hpp"
+#include "../../include/linkedList.hpp"
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+uint32_t RadixSort::priceToCents(double price) {
+    if (!(price > 0.0)) return 0;   // Also catches NaN
+    double cents = std::floor(price * 100.0 + 0.5);
+    if (cents >= 4294967295.0) return 0xFFFFFFFFu;
+    return (uint32_t)cents;
+}
+
+uint64_t RadixSort::extractKey(const TransactionData& transaction, RadixKey key) {
+    uint64_t date = transaction.dateKey;
+    uint64_t cents = priceToCents(transaction.price);
+    switch (key) {
+        case RADIX_BY_DATE: return date;
+        case RADIX_BY_PRICE: return cents;
+        case RADIX_BY_DATE_THEN_PRICE: return (date << 32) | cents;
+        case RADIX_BY_PRICE_THEN_DATE: return (cents << 32) | date;
+    }
+    return 0;
+}
+
+uint64_t RadixSort::extractKey(const TransactionNode& transaction, RadixKey key) {
+    uint64_t date = transaction.dateKey;
+    uint64_t cents = priceToCents(transaction.price);
+    switch (key) {
+        case RADIX_BY_DATE: return date;
+        case RADIX_BY_PRICE: return cents;
+        case RADIX_BY_DATE_THEN_PRICE: return (date << 32) | cents;
+        case RADIX_BY_PRICE_THEN_DATE: return (cents << 32) | date;
+    }
+    return 0;
+}
+
+uint64_t RadixSort::varyingBits(const uint64_t* keys, size_t n) {
+    if (n == 0) return 0;
+    uint64_t allOr = 0;
+    uint64_t allAnd = ~(uint64_t)0;
+    for (size_t i = 0; i < n; i++) {
+        allOr |= keys[i];
+        allAnd &= keys[i];
+    }
+    return allOr ^ allAnd;
+}
+
+void RadixSort::sortKeys(uint64_t* keys, size_t* rows, size_t n) {
+    if (n <= 1) return;
+
+    uint64_t varying = varyingBits(keys, n);
+    if (varying == 0) return;   // All keys equal
+
+    // One histogram per byte, all built in a single pass
+    size_t (*counts)[BUCKETS] = new size_t[KEY_BYTES][BUCKETS];
+    memset(counts, 0, sizeof(size_t) * KEY_BYTES * BUCKETS);
+    for (size_t i = 0; i < n; i++) {
+        uint64_t k = keys[i];
+        for (int b = 0; b < KEY_BYTES; b++) {
+            counts[b][(k >> (b * RADIX_BITS)) & (BUCKETS - 1)]++;
+        }
+    }
+
+    uint64_t* keyBuffer = new uint64_t[n];
+    size_t* rowBuffer = new size_t[n];
+    uint64_t* srcKeys = keys;
+    size_t* srcRows = rows;
+    uint64_t* dstKeys = keyBuffer;
+    size_t* dstRows = rowBuffer;
+
+    for (int b = 0; b < KEY_BYTES; b++) {
+        int shift = b * RADIX_BITS;
+        if (((varying >> shift) & (BUCKETS - 1)) == 0) continue;
+
+        // Prefix sums turn counts into bucket start positions
+        size_t offsets[BUCKETS];
+        size_t total = 0;
+        for (size_t d = 0; d < BUCKETS; d++) {
+            offsets[d] = total;
+            total += counts[b][d];
+        }
+
+        // Scatter in input order, which keeps each pass stable
+        for (size_t i = 0; i < n; i++) {
+            size_t pos = offsets[(srcKeys[i] >> shift) & (BUCKETS - 1)]++;
+            dstKeys[pos] = srcKeys[i];
+            dstRows[pos] = srcRows[i];
+        }
+
+        std::swap(srcKeys, dstKeys);
+        std::swap(srcRows, dstRows);
+    }
+
+    if (srcKeys != keys) {
+        memcpy(keys, srcKeys, sizeof(uint64_t) * n);
+        memcpy(rows, srcRows, sizeof(size_t) * n);
+    }
+
+    delete[] keyBuffer;
+    delete[] rowBuffer;
+    delete[] counts;
+}
+
+void RadixSort::sortArray(TransactionArray& transactions, RadixKey key) {
+    size_t n = transactions.size();
+    if (n <= 1) return;
+
+    TransactionData* arr = transactions.getDataPtr();
+    uint64_t* keys = new uint64_t[n];
+    size_t* order = new size_t[n];
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = extractKey(arr[i], key);
+        order[i] = i;
+    }
+
+    sortKeys(keys, order, n);
+    delete[] keys;
+
+    // Apply the permutation in place by following its cycles:
+    // position i must receive the row currently at order[i]
+    for (size_t start = 0; start < n; start++) {
+        if (order[start] == start) continue;
+
+        TransactionData saved = std::move(arr[start]);
+        size_t current = start;
+        while (order[current] != start) {
+            size_t from = order[current];
+            arr[current] = std::move(arr[from]);
+            order[current] = current;   // Mark as placed
+            current = from;
+        }
+        arr[current] = std::move(saved);
+        order[current] = current;
+    }
+
+    delete[] order;
+}
+
+void RadixSort::sortList(TransactionNode*& head, RadixKey key) {
+    if (!head || !head->next) return;
+
+    uint64_t allOr = 0;
+    uint64_t allAnd = ~(uint64_t)0;
+    for (TransactionNode* node = head; node; node = node->next) {
+        uint64_t k = extractKey(*node, key);
+        allOr |= k;
+        allAnd &= k;
+    }
+    uint64_t varying = allOr ^ allAnd;
+
+    TransactionNode* bucketHead[BUCKETS];
+    TransactionNode* bucketTail[BUCKETS];
+
+    for (int b = 0; b < KEY_BYTES; b++) {
+        int shift = b * RADIX_BITS;
+        if (((varying >> shift) & (BUCKETS - 1)) == 0) continue;
+
+        for (size_t d = 0; d < BUCKETS; d++) bucketHead[d] = bucketTail[d] = nullptr;
+
+        // Append every node to its bucket in list order (stable)
+        for (TransactionNode* node = head; node;) {
+            TransactionNode* next = node->next;
+            size_t digit = (extractKey(*node, key) >> shift) & (BUCKETS - 1);
+            node->next = nullptr;
+            if (bucketTail[digit]) bucketTail[digit]->next = node;
+            else bucketHead[digit] = node;
+            bucketTail[digit] = node;
+            node = next;
+        }
+
+        // Concatenate the buckets back into one list
+        TransactionNode* tail = nullptr;
+        head = nullptr;
+        for (size_t d = 0; d < BUCKETS; d++) {
+            if (!bucketHead[d]) continue;
+            if (tail) tail->next = bucketHead[d];
+            else head = bucketHead[d];
+            tail = bucketTail[d];
+        }
+    }
+}
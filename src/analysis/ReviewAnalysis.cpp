@@ -1,8 +1,15 @@
 #include "../../include/KeithHPP.hpp"
+#include "../../include/csvReader.hpp"
+#include "../../include/wordCounter.hpp"
+#include "../../include/parallelWordCount.hpp"
+#include "../../include/tokenizer.hpp"
+#include "../../include/snapshot.hpp"
+#include "../../include/nodePool.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <vector>
 using namespace std;
 
 struct Review {
@@ -63,25 +70,29 @@ public:
     int getSize() const { return size; }
 };
 
+// Nodes come from a NodePool, so reviews added in order are adjacent in
+// memory and the whole list is freed chunk by chunk
 class ReviewList {
 private:
+    NodePool<ReviewNode> nodes;
     ReviewNode* head;
     ReviewNode* tail;
     int size;
 
 public:
     ReviewList() : head(nullptr), tail(nullptr), size(0) {}
-    
-    ~ReviewList() {
-        while (head) {
-            ReviewNode* temp = head;
-            head = head->next;
-            delete temp;
-        }
+
+    ReviewList(const ReviewList&) = delete;
+    ReviewList& operator=(const ReviewList&) = delete;
+
+    ReviewList(ReviewList&& other) noexcept
+        : nodes(std::move(other.nodes)), head(other.head), tail(other.tail), size(other.size) {
+        other.head = other.tail = nullptr;
+        other.size = 0;
     }
     
     void add(const Review& review) {
-        ReviewNode* newNode = new ReviewNode(review);
+        ReviewNode* newNode = nodes.create(review);
         if (!head) {
             head = tail = newNode;
         } else {
@@ -91,6 +102,21 @@ public:
         size++;
     }
     
+    // Moves all nodes of other onto the end of this list in O(1)
+    void splice(ReviewList& other) {
+        if (!other.head) return;
+        nodes.absorb(other.nodes);
+        if (!head) {
+            head = other.head;
+        } else {
+            tail->next = other.head;
+        }
+        tail = other.tail;
+        size += other.size;
+        other.head = other.tail = nullptr;
+        other.size = 0;
+    }
+    
     ReviewNode* getHead() const { return head; }
     bool empty() const { return head == nullptr; }
     int getSize() const { return size; }
@@ -150,62 +176,88 @@ public:
 
 class ReviewAnalyzer {
 private:
-    WordFreqList wordFrequency;
+    WordCounter wordCounts;   // Hash-based counts; top words are picked at the end
+    int targetRating;         // Only reviews with this rating are counted
 
-    StringList tokenizeText(const string& text) {
-        StringList tokens;
-        string word;
-        stringstream ss(text);
-        
-        while (ss >> word) {
-            string cleanWord;
-            for (char c : word) {
-                if (isalnum(c)) {
-                    cleanWord += tolower(c);
-                }
-            }
-            
-            if (cleanWord.length() > 2) {
-                tokens.add(cleanWord);
+    // Calls onWord(ptr, len) for each whitespace-separated token, reduced
+    // to its lowercased letters and digits, that is longer than two chars
+    template <typename OnWord>
+    void tokenizeText(const char* text, size_t len, OnWord onWord) {
+        Tokenizer::forEachToken(text, len, Tokenizer::NON_SPACE, [&](const char* token, size_t len) {
+            TokenBuffer cleanWord(token, len, Tokenizer::ALNUM);
+            if (cleanWord.size() > 2) {
+                onWord(cleanWord.data(), cleanWord.size());
             }
-        }
-        return tokens;
+        });
+    }
+
+    void countText(const char* text, size_t len, WordCounter& counts) {
+        tokenizeText(text, len, [&counts](const char* word, size_t wordLen) {
+            counts.add(word, wordLen);
+        });
+    }
+
+    void countReview(const Review& review, WordCounter& counts) {
+        countText(review.reviewText.data(), review.reviewText.size(), counts);
     }
 
     void processReview(const Review& review) {
-        if (review.rating == 1) {
-            StringList tokens = tokenizeText(review.reviewText);
-            for (StringNode* curr = tokens.getHead(); curr != nullptr; curr = curr->next) {
-                bool found = false;
-                WordFreqNode* current = wordFrequency.getHead();
-                while (current) {
-                    if (current->word == curr->data) {
-                        current->frequency++;
-                        found = true;
-                        break;
-                    }
-                    current = current->next;
-                }
-                if (!found) {
-                    wordFrequency.add(curr->data, 1);
-                }
-            }
+        if (review.rating == targetRating) {
+            countReview(review, wordCounts);
         }
     }
 
 public:
+    explicit ReviewAnalyzer(int rating = 1) : targetRating(rating) {}
+
     void analyzeReviews(const ReviewList& reviews) {
         for (ReviewNode* curr = reviews.getHead(); curr != nullptr; curr = curr->next) {
             processReview(curr->data);
         }
     }
 
+    // Same counts as analyzeReviews, computed on several threads.
+    // threads == 0 uses one per hardware thread.
+    void analyzeReviewsParallel(const ReviewList& reviews, unsigned threads = 0) {
+        vector<const ReviewNode*> matching;
+        ParallelWordCount::collect(reviews.getHead(), [this](const ReviewNode& node) {
+            return node.data.rating == targetRating;
+        }, matching);
+
+        ParallelWordCount::count(matching, wordCounts, [this](const ReviewNode* node, WordCounter& counts) {
+            countReview(node->data, counts);
+        }, threads);
+    }
+
+    // Same counts, read straight from a mapped reviews snapshot
+    void analyzeSnapshot(const ReviewSnapshot& reviews, unsigned threads = 0) {
+        // Each text is a view into the mapping, with its stored length
+        vector<FieldView> matching;
+        for (size_t row = 0; row < reviews.size(); row++) {
+            if (reviews.rating(row) == targetRating) matching.push_back(reviews.text(row));
+        }
+
+        ParallelWordCount::count(matching, wordCounts, [this](const FieldView& text, WordCounter& counts) {
+            countText(text.ptr, text.len, counts);
+        }, threads);
+    }
+
+    // Top n words by frequency, selected with a heap over the counts
     WordFreqList* getTopWords(int n) {
-        return wordFrequency.getTopN(n);
+        WordFreqList* result = new WordFreqList();
+        if (n <= 0) return result;
+
+        vector<uint32_t> ids(n);
+        size_t found = wordCounts.topN(n, ids.data());
+        for (size_t i = 0; i < found; i++) {
+            result->add(string(wordCounts.word(ids[i]), wordCounts.wordLength(ids[i])),
+                        wordCounts.frequency(ids[i]));
+        }
+        return result;
     }
 
     void printResults(int topN = 10) {
-        cout << "\nTop " << topN << " most frequent words in 1-star reviews:\n";
+        cout << "\nTop " << topN << " most frequent words in " << targetRating << "-star reviews:\n";
         cout << "----------------------------------------\n";
         
         WordFreqList* topWords = getTopWords(topN);
@@ -255,16 +307,83 @@ ReviewList loadReviews(const string& filename) {
     return reviews;
 }
 
+// Parses one "productID,customerID,rating,text" line with the same rules as loadReviews
+bool parseReviewLine(const FieldView& line, Review& review) {
+    FieldView fields[4];
+    if (splitFields(line, ',', fields, 4) < 3) return false;
+
+    int rating = 0;
+    if (!parseInt(fields[2], rating) || rating < 1 || rating > 5) return false;
+
+    review.productID.assign(fields[0].ptr, fields[0].len);
+    review.customerID.assign(fields[1].ptr, fields[1].len);
+    review.rating = rating;
+    if (fields[3].ptr) {
+        review.reviewText.assign(fields[3].ptr, fields[3].len);
+    } else {
+        review.reviewText.clear();
+    }
+    return true;
+}
+
+// Parallel ingest: the mapped file is split into newline-aligned ranges,
+// each parsed into its own ReviewList, and the lists are spliced in file
+// order. workers == 0 uses one worker per hardware thread.
+ReviewList loadReviewsParallel(const string& filename, unsigned workers = 0) {
+    ReviewList reviews;
+    MappedFile file;
+
+    if (!file.open(filename)) {
+        cout << "Error: Cannot open " << filename << endl;
+        return reviews;
+    }
+
+    LineCursor cursor(file.begin(), file.end());
+    FieldView line;
+    cursor.next(line); // Skip header
+
+    vector<const char*> bounds;
+    size_t chunks = splitLineAlignedChunks(cursor.position(), file.end(),
+                                           workers == 0 ? defaultWorkerCount() : workers, bounds);
+    vector<ReviewList> parts(chunks);
+
+    parallelForChunks(bounds, [&](size_t chunk, const char* begin, const char* end) {
+        LineCursor local(begin, end);
+        FieldView row;
+        while (local.next(row)) {
+            Review review;
+            if (parseReviewLine(row, review)) {
+                parts[chunk].add(review);
+            }
+        }
+    });
+
+    for (size_t chunk = 0; chunk < chunks; chunk++) {
+        reviews.splice(parts[chunk]);
+    }
+    return reviews;
+}
+
 int main() {
-    ReviewList reviews = loadReviews("data/reviewsClean.csv");
+    ReviewAnalyzer analyzer(1);
+
+    // The cleaner's binary snapshot is mapped and read in place; the CSV
+    // is parsed only when there is no snapshot
+    ReviewSnapshot snapshot;
+    if (snapshot.open("data/reviewsClean.snap") && !snapshot.empty()) {
+        analyzer.analyzeSnapshot(snapshot);
+        analyzer.printResults(10);
+        return 0;
+    }
+
+    ReviewList reviews = loadReviewsParallel("data/reviewsClean.csv");
     
     if (reviews.empty()) {
         cout << "No reviews loaded. Exiting...\n";
         return 1;
     }
     
-    ReviewAnalyzer analyzer;
-    analyzer.analyzeReviews(reviews);
+    analyzer.analyzeReviewsParallel(reviews);
     analyzer.printResults(10);
     
     return 0;
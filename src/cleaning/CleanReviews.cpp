@@ -1,175 +1,210 @@
 #include <iostream>
 #include <fstream>
-#include <sstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
 #include <cstring>
 #include <cctype>
+#include "../../include/csvReader.hpp"
+#include "../../include/tokenizer.hpp"
+#include "../../include/snapshot.hpp"
 
 using namespace std;
 
-struct Review {
-    string productID, customerID, reviewText;
+// One valid review. The views point into the reader's current block (the
+// text is cleaned in place there) and are only valid while the batch
+// holding the review is being handled.
+struct CleanReview {
+    FieldView productID, customerID, ratingText, reviewText;
     int rating;
 };
 
-struct ReviewNode {
-    Review data;
-    ReviewNode* next;
-    ReviewNode(const Review& r) : data(r), next(nullptr) {}
+// The valid reviews of one input block, in file order
+struct ReviewBatch {
+    const CleanReview* rows;
+    size_t count;
 };
 
-class ReviewList {
-private:
-    ReviewNode* head;
-    int count;
-
-public:
-    ReviewList() : head(nullptr), count(0) {}
-    
-    ~ReviewList() {
-        ReviewNode* current = head;
-        while (current != nullptr) {
-            ReviewNode* next = current->next;
-            delete current;
-            current = next;
-        }
+bool isValidInteger(const FieldView& field) {
+    for (size_t i = 0; i < field.len; i++) {
+        if (!isdigit((unsigned char)field.ptr[i])) return false;
     }
+    return !field.empty();
+}
 
-    void add(const Review& r) {
-        ReviewNode* newNode = new ReviewNode(r);
-        newNode->next = head;
-        head = newNode;
-        count++;
+// Value of an all-digit field, stopping once it is above limit
+int parseBoundedInteger(const FieldView& field, int limit) {
+    int value = 0;
+    for (size_t i = 0; i < field.len && value <= limit; i++) {
+        value = value * 10 + (field.ptr[i] - '0');
     }
+    return value;
+}
 
-    int getCount() const { return count; }
+// Lowercases the text and keeps letters, digits and whitespace, compacting
+// in place. Returns the new length.
+size_t cleanText(char* text, size_t len) {
+    Tokenizer::toLower(text, len, text);
+    return Tokenizer::keepClasses(text, len, Tokenizer::ALNUM | Tokenizer::SPACE);
+}
 
-    void toArray(Review*& arr) {
-        arr = new Review[count];
-        ReviewNode* current = head;
-        int i = count - 1;
-        while (current != nullptr) {
-            arr[i] = current->data;
-            current = current->next;
-            i--;
-        }
+// Validates one line, reporting every problem found. line must point into a
+// writable block: the review text is cleaned where it lies. Fills r and
+// returns true if the review is clean.
+bool cleanReviewLine(char* line, size_t len, size_t lineNumber, CleanReview& r) {
+    FieldView fields[4];
+    splitFields(FieldView(line, len), ',', fields, 4);
+    const FieldView& productID = fields[0];
+    const FieldView& customerID = fields[1];
+    const FieldView& ratingStr = fields[2];
+
+    bool isValid = true;
+
+    if (productID.empty() || customerID.empty() || ratingStr.empty()) {
+        cout << "Line " << lineNumber << ": Missing required field(s)\n";
+        isValid = false;
     }
-};
-
-// Utility functions
-string toLowerCase(string str) {
-    for (char &c : str) c = tolower(c);
-    return str;
-}
 
-bool isValidInteger(const string &str) {
-    for(char c : str) {
-        if(!isdigit(c)) return false;
+    if (ratingStr.equals("Invalid Rating")) {
+        cout << "Line " << lineNumber << ": Invalid Rating found\n";
+        isValid = false;
     }
-    return !str.empty();
-}
 
-string cleanText(string text) {
-    string result;
-    for(char c : text) {
-        if(isalnum(c) || isspace(c)) {
-            result += c;
+    int rating = 0;
+    if (!isValidInteger(ratingStr)) {
+        cout << "Line " << lineNumber << ": Rating must be a number\n";
+        isValid = false;
+    } else {
+        rating = parseBoundedInteger(ratingStr, 5);
+        if (rating < 1 || rating > 5) {
+            cout << "Line " << lineNumber << ": Rating must be between 1 and 5\n";
+            isValid = false;
         }
     }
-    return result;
-}
 
-int cleanReviews(Review *&reviews, int &size) {
-    ifstream inFile("data/reviews.csv");
-    if (!inFile.is_open()) {
-        cout << "Error: Cannot open data/reviews.csv\n";
-        return 0;
+    FieldView reviewText;
+    if (fields[3].ptr) {
+        char* text = line + (fields[3].ptr - line);
+        reviewText = FieldView(text, cleanText(text, fields[3].len));
     }
-
-    ofstream outFile("data/reviewsClean.csv");
-    if (!outFile.is_open()) {
-        cout << "Error: Cannot create data/reviewsClean.csv\n";
-        inFile.close();
-        return 0;
+    if (reviewText.empty()) {
+        cout << "Line " << lineNumber << ": Empty review text after cleaning\n";
+        isValid = false;
     }
 
-    string line;
-    getline(inFile, line);  // Read header
-    outFile << line << endl;  // Write header to new file
-
-    ReviewList validReviews;
-    int lineNumber = 1;
+    if (!isValid) return false;
 
-    while (getline(inFile, line)) {
-        lineNumber++;
-        stringstream ss(line);
-        string productID, customerID, ratingStr, reviewText;
-        
-        getline(ss, productID, ',');
-        getline(ss, customerID, ',');
-        getline(ss, ratingStr, ',');
-        getline(ss, reviewText);
+    r.productID = productID;
+    r.customerID = customerID;
+    r.ratingText = ratingStr;
+    r.rating = rating;
+    r.reviewText = reviewText;
+    return true;
+}
 
-        bool isValid = true;
+void appendField(string& out, const FieldView& field) {
+    out.append(field.ptr, field.len);
+}
 
-        if (productID.empty() || customerID.empty() || ratingStr.empty()) {
-            cout << "Line " << lineNumber << ": Missing required field(s)\n";
-            isValid = false;
-        }
+// Streams inPath through validation one block at a time: each block's valid
+// reviews are written to outPath and handed to onBatch(const ReviewBatch&),
+// then dropped. Memory stays at one block and its row views whatever the
+// file size, so nothing downstream may keep the views past its batch.
+// validCount receives the number of valid reviews; false if a file cannot be opened.
+template <typename BatchSink>
+bool cleanReviews(const string& inPath, const string& outPath, BatchSink onBatch,
+                  size_t& validCount, size_t blockSize = 1 << 20) {
+    validCount = 0;
+
+    BlockLineReader reader(blockSize);
+    if (!reader.open(inPath)) {
+        cout << "Error: Cannot open " << inPath << "\n";
+        return false;
+    }
 
-        if (ratingStr == "Invalid Rating") {
-            cout << "Line " << lineNumber << ": Invalid Rating found\n";
-            isValid = false;
-        }
+    ofstream outFile(outPath);
+    if (!outFile.is_open()) {
+        cout << "Error: Cannot create " << outPath << "\n";
+        return false;
+    }
 
-        if (!isValidInteger(ratingStr)) {
-            cout << "Line " << lineNumber << ": Rating must be a number\n";
-            isValid = false;
-        } else {
-            int rating = stoi(ratingStr);
-            if (rating < 1 || rating > 5) {
-                cout << "Line " << lineNumber << ": Rating must be between 1 and 5\n";
-                isValid = false;
+    vector<CleanReview> rows;
+    string output;   // Clean CSV text of the current block
+    size_t lineNumber = 0;
+    char* begin;
+    char* end;
+
+    while (reader.nextBlock(begin, end)) {
+        rows.clear();
+        output.clear();
+
+        LineCursor cursor(begin, end);
+        FieldView line;
+        while (cursor.next(line)) {
+            lineNumber++;
+            if (lineNumber == 1) {
+                // The header is copied as is
+                appendField(output, line);
+                output += '\n';
+                continue;
             }
-        }
 
-        reviewText = cleanText(toLowerCase(reviewText));
-        if (reviewText.empty()) {
-            cout << "Line " << lineNumber << ": Empty review text after cleaning\n";
-            isValid = false;
+            CleanReview r;
+            if (!cleanReviewLine(begin + (line.ptr - begin), line.len, lineNumber, r)) continue;
+            rows.push_back(r);
+
+            appendField(output, r.productID);
+            output += ',';
+            appendField(output, r.customerID);
+            output += ',';
+            appendField(output, r.ratingText);
+            output += ',';
+            appendField(output, r.reviewText);
+            output += '\n';
         }
 
-        if (!isValid) continue;
-
-        Review r;
-        r.productID = productID;
-        r.customerID = customerID;
-        r.rating = stoi(ratingStr);
-        r.reviewText = reviewText;
-        validReviews.add(r);
-
-        outFile << productID << "," << customerID << "," 
-               << ratingStr << "," << reviewText << endl;
+        outFile.write(output.data(), output.size());
+        if (!rows.empty()) {
+            ReviewBatch batch = {rows.data(), rows.size()};
+            onBatch(batch);
+        }
+        validCount += rows.size();
     }
 
-    inFile.close();
     outFile.close();
-
-    cout << "Cleaned reviews saved to data/reviewsClean.csv\n";
-
-    size = validReviews.getCount();
-    validReviews.toArray(reviews);
-
-    return size;
+    cout << "Cleaned reviews saved to " << outPath << "\n";
+    return true;
 }
 
 int main() {
-    Review *reviews = nullptr;
-    int reviewSize = 0;
+    // The binary snapshot is built from the same batches as the clean CSV
+    ReviewSnapshotBuilder snapshot;
+    bool writeSnapshot = snapshot.open("data/reviewsClean.snap");
+    if (!writeSnapshot) cout << "Error: Cannot create data/reviewsClean.snap\n";
 
     cout << "Cleaning reviews...\n";
-    cleanReviews(reviews, reviewSize);
+    size_t reviewSize = 0;
+    bool cleaned = cleanReviews("data/reviews.csv", "data/reviewsClean.csv",
+        [&](const ReviewBatch& batch) {
+            if (!writeSnapshot) return;
+            // A full dictionary ends the snapshot but not the clean CSV
+            try {
+                for (size_t i = 0; i < batch.count; i++) {
+                    const CleanReview& r = batch.rows[i];
+                    snapshot.append(r.productID, r.customerID, r.rating, r.reviewText);
+                }
+            } catch (const overflow_error& e) {
+                cout << "Error: Cannot write data/reviewsClean.snap: " << e.what() << "\n";
+                snapshot.abandon();
+                writeSnapshot = false;
+            }
+        }, reviewSize);
+
+    if (cleaned && writeSnapshot) {
+        if (snapshot.finish()) cout << "Binary snapshot saved to data/reviewsClean.snap\n";
+        else cout << "Error: Cannot write data/reviewsClean.snap\n";
+    }
     cout << "Loaded " << reviewSize << " valid reviews.\n";
 
-    delete[] reviews;
     return 0;
 }
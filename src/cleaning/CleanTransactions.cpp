@@ -1,224 +1,250 @@
 #include <iostream>
 #include <fstream>
-#include <sstream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <cerrno>
+#include <cstdlib>
 #include <cstring>
 #include <cctype>
+#include "../../include/csvReader.hpp"
+#include "../../include/dateKey.hpp"
+#include "../../include/snapshot.hpp"
 
 using namespace std;
 
-struct Transaction {
-    string customerID, product, date, category, paymentMethod;
-    float price;
+// One valid row. The views point into the reader's current block and are
+// only valid while the batch holding the row is being handled.
+struct CleanTransaction {
+    FieldView customerID, product, category, priceText, date, paymentMethod;
+    double price;
+    uint32_t dateKey;
 };
 
-struct TransactionNode {
-    Transaction data;
-    TransactionNode* next;
-    TransactionNode(const Transaction& t) : data(t), next(nullptr) {}
+// The valid rows of one input block, in file order
+struct TransactionBatch {
+    const CleanTransaction* rows;
+    size_t count;
 };
 
-class TransactionList {
-private:
-    TransactionNode* head;
-    int count;
-
-public:
-    TransactionList() : head(nullptr), count(0) {}
-    
-    ~TransactionList() {
-        TransactionNode* current = head;
-        while (current != nullptr) {
-            TransactionNode* next = current->next;
-            delete current;
-            current = next;
-        }
-    }
-
-    void add(const Transaction& t) {
-        TransactionNode* newNode = new TransactionNode(t);
-        newNode->next = head;
-        head = newNode;
-        count++;
-    }
-
-    int getCount() const { return count; }
-
-    void toArray(Transaction*& arr) {
-        arr = new Transaction[count];
-        TransactionNode* current = head;
-        int i = count - 1;
-        while (current != nullptr) {
-            arr[i] = current->data;
-            current = current->next;
-            i--;
-        }
+// Accepts what reading a float with operator>> accepts: optional leading
+// whitespace, then a number that uses up the rest of the field
+bool isValidFloat(const FieldView& field) {
+    char buffer[64];
+    if (field.len == 0 || field.len >= sizeof(buffer)) return false;
+    memcpy(buffer, field.ptr, field.len);
+    buffer[field.len] = '\0';
+
+    size_t start = 0;
+    while (start < field.len && isspace((unsigned char)buffer[start])) start++;
+    if (start == field.len) return false;
+
+    // strtof also takes "nan", "inf" and hex floats, which the stream read rejects
+    for (size_t i = start; i < field.len; i++) {
+        char c = buffer[i];
+        if (!isdigit((unsigned char)c) && c != '+' && c != '-' && c != '.' && c != 'e' && c != 'E') return false;
     }
-};
-
-string toLowerCase(string str) {
-    for (char &c : str) c = tolower(c);
-    return str;
-}
-
-bool isValidFloat(const string &str) {
-    stringstream ss(str);
-    float f;
-    return (ss >> f) && (ss.eof());
-}
 
-bool isValidInteger(const string &str) {
-    for (char const &c : str) {
-        if (std::isdigit(c) == 0) return false;
-    }
-    return true;
+    errno = 0;
+    char* end = nullptr;
+    strtof(buffer + start, &end);
+    return end == buffer + field.len && errno != ERANGE;
 }
 
-bool isValidDate(const string &date) {
-    if(date.length() != 10) return false;
-    if(date[2] != '/' || date[5] != '/') return false;
-    
-    string dayStr = date.substr(0,2);
-    string monthStr = date.substr(3,2);
-    string yearStr = date.substr(6,4);
-    
-    if(!isValidInteger(dayStr) || !isValidInteger(monthStr) || !isValidInteger(yearStr))
-        return false;
-        
-    int day = stoi(dayStr);
-    int month = stoi(monthStr);
-    int year = stoi(yearStr);
-    
-    return (year >= 2000 && year <= 2024) && 
-           (month >= 1 && month <= 12) && 
-           (day >= 1 && day <= 31);
+// "DD/MM/YYYY" between 2000 and 2024; key receives the date as yyyymmdd
+bool isValidDate(const FieldView& date, uint32_t& key) {
+    key = parseDateKey(date.ptr, date.len);
+    if (key == 0) return false;
+    uint32_t year = dateKeyYear(key);
+    return year >= 2000 && year <= 2024;
 }
 
-bool isValidCategory(const string &category) {
-    string validCategories[] = {
+bool isValidCategory(const FieldView& category) {
+    static const char* validCategories[] = {
         "Electronics", "Fashion", "Books", "Automotive", "Beauty",
         "Sports", "Toys", "Furniture", "Groceries", "Home Appliances"
     };
-    string cat = toLowerCase(category);
-    for(const string &valid : validCategories) {
-        if(toLowerCase(valid) == cat) return true;
+    for (const char* valid : validCategories) {
+        if (category.equalsIgnoreCase(valid)) return true;
     }
     return false;
 }
 
-bool isValidPaymentMethod(const string &method) {
-    string validMethods[] = {
+bool isValidPaymentMethod(const FieldView& method) {
+    static const char* validMethods[] = {
         "Credit Card", "Debit Card", "Cash", "PayPal",
         "Bank Transfer", "Cash on Delivery"
     };
-    string m = toLowerCase(method);
-    for(const string &valid : validMethods) {
-        if(toLowerCase(valid) == m) return true;
+    for (const char* valid : validMethods) {
+        if (method.equalsIgnoreCase(valid)) return true;
     }
     return false;
 }
 
-int cleanTransactions(Transaction *&transactions, int &size) {
-    ifstream inFile("data/transactions.csv");
-    if (!inFile.is_open()) {
-        cout << "Error: Cannot open data/transactions.csv\n";
-        return 0;
-    }
-
-    ofstream outFile("data/transactionsClean.csv");
-    if (!outFile.is_open()) {
-        cout << "Error: Cannot create data/transactionsClean.csv\n";
-        inFile.close();
-        return 0;
+// Validates one line, reporting every problem found. Fills t and returns
+// true if the line is clean.
+bool cleanTransactionLine(const FieldView& line, size_t lineNumber, CleanTransaction& t) {
+    FieldView fields[6];
+    splitFields(line, ',', fields, 6);
+    const FieldView& customerID = fields[0];
+    const FieldView& product = fields[1];
+    const FieldView& category = fields[2];
+    const FieldView& priceStr = fields[3];
+    const FieldView& date = fields[4];
+    const FieldView& paymentMethod = fields[5];
+
+    bool isValid = true;
+
+    if (customerID.empty() || product.empty() || category.empty() ||
+        priceStr.empty() || date.empty() || paymentMethod.empty()) {
+        cout << "Line " << lineNumber << ": Missing required field(s)\n";
+        isValid = false;
     }
 
-    string line;
-    getline(inFile, line);
-    outFile << "Customer|Product,Category,Price,Date,Payment Method" << endl;
-
-    TransactionList validTransactions;
-    int lineNumber = 1;
-
-    while (getline(inFile, line)) {
-        lineNumber++;
-        stringstream ss(line);
-        string customerID, product, category, priceStr, date, paymentMethod;
-        
-        getline(ss, customerID, ',');
-        getline(ss, product, ',');
-        getline(ss, category, ',');
-        getline(ss, priceStr, ',');
-        getline(ss, date, ',');
-        getline(ss, paymentMethod);
-
-        bool isValid = true;
-
-        if (customerID.empty() || product.empty() || category.empty() || 
-            priceStr.empty() || date.empty() || paymentMethod.empty()) {
-            cout << "Line " << lineNumber << ": Missing required field(s)\n";
+    double price = 0.0;
+    if (!isValidFloat(priceStr)) {
+        cout << "Line " << lineNumber << ": Invalid price format\n";
+        isValid = false;
+    } else {
+        parseDouble(priceStr, price);
+        if (price <= 0) {
+            cout << "Line " << lineNumber << ": Price must be positive\n";
             isValid = false;
         }
+    }
 
-        if (!isValidFloat(priceStr)) {
-            cout << "Line " << lineNumber << ": Invalid price format\n";
-            isValid = false;
-        } else {
-            float price = stof(priceStr);
-            if (price <= 0) {
-                cout << "Line " << lineNumber << ": Price must be positive\n";
-                isValid = false;
-            }
-        }
+    uint32_t dateKey = 0;
+    if (!isValidDate(date, dateKey)) {
+        cout << "Line " << lineNumber << ": Invalid date format (use MM/DD/YYYY)\n";
+        isValid = false;
+    }
 
-        if (!isValidDate(date)) {
-            cout << "Line " << lineNumber << ": Invalid date format (use MM/DD/YYYY)\n";
-            isValid = false;
-        }
+    if (!isValidCategory(category)) {
+        cout << "Line " << lineNumber << ": Invalid category\n";
+        isValid = false;
+    }
 
-        if (!isValidCategory(category)) {
-            cout << "Line " << lineNumber << ": Invalid category\n";
-            isValid = false;
-        }
+    if (!isValidPaymentMethod(paymentMethod)) {
+        cout << "Line " << lineNumber << ": Invalid payment method\n";
+        isValid = false;
+    }
 
-        if (!isValidPaymentMethod(paymentMethod)) {
-            cout << "Line " << lineNumber << ": Invalid payment method\n";
-            isValid = false;
-        }
+    if (!isValid) return false;
 
-        if (!isValid) continue;
+    t.customerID = customerID;
+    t.product = product;
+    t.category = category;
+    t.priceText = priceStr;
+    t.price = price;
+    t.date = date;
+    t.dateKey = dateKey;
+    t.paymentMethod = paymentMethod;
+    return true;
+}
 
-        Transaction t;
-        t.customerID = customerID;
-        t.product = product;
-        t.category = category;
-        t.price = stof(priceStr);
-        t.date = date;
-        t.paymentMethod = paymentMethod;
-        validTransactions.add(t);
+void appendField(string& out, const FieldView& field) {
+    out.append(field.ptr, field.len);
+}
 
-        outFile << customerID << "|" << product << ","
-               << category << "," << priceStr << "," 
-               << date << "," << paymentMethod << endl;
+// Streams inPath through validation one block at a time: each block's valid
+// rows are written to outPath and handed to onBatch(const TransactionBatch&),
+// then dropped. Memory stays at one block and its row views whatever the
+// file size, so nothing downstream may keep the views past its batch.
+// validCount receives the number of valid rows; false if a file cannot be opened.
+template <typename BatchSink>
+bool cleanTransactions(const string& inPath, const string& outPath, BatchSink onBatch,
+                       size_t& validCount, size_t blockSize = 1 << 20) {
+    validCount = 0;
+
+    BlockLineReader reader(blockSize);
+    if (!reader.open(inPath)) {
+        cout << "Error: Cannot open " << inPath << "\n";
+        return false;
     }
 
-    inFile.close();
-    outFile.close();
-
-    cout << "Cleaned transactions saved to data/transactionsClean.csv\n";
+    ofstream outFile(outPath);
+    if (!outFile.is_open()) {
+        cout << "Error: Cannot create " << outPath << "\n";
+        return false;
+    }
+    outFile << "Customer|Product,Category,Price,Date,Payment Method\n";
+
+    vector<CleanTransaction> rows;
+    string output;   // Clean CSV text of the current block
+    size_t lineNumber = 0;
+    char* begin;
+    char* end;
+
+    while (reader.nextBlock(begin, end)) {
+        rows.clear();
+        output.clear();
+
+        LineCursor cursor(begin, end);
+        FieldView line;
+        while (cursor.next(line)) {
+            lineNumber++;
+            if (lineNumber == 1) continue;   // Header
+
+            CleanTransaction t;
+            if (!cleanTransactionLine(line, lineNumber, t)) continue;
+            rows.push_back(t);
+
+            appendField(output, t.customerID);
+            output += '|';
+            appendField(output, t.product);
+            output += ',';
+            appendField(output, t.category);
+            output += ',';
+            appendField(output, t.priceText);
+            output += ',';
+            appendField(output, t.date);
+            output += ',';
+            appendField(output, t.paymentMethod);
+            output += '\n';
+        }
 
-    size = validTransactions.getCount();
-    validTransactions.toArray(transactions);
+        outFile.write(output.data(), output.size());
+        if (!rows.empty()) {
+            TransactionBatch batch = {rows.data(), rows.size()};
+            onBatch(batch);
+        }
+        validCount += rows.size();
+    }
 
-    return size;
+    outFile.close();
+    cout << "Cleaned transactions saved to " << outPath << "\n";
+    return true;
 }
 
 int main() {
-    Transaction *transactions = nullptr;
-    int transSize = 0;
+    // The binary snapshot is built from the same batches as the clean CSV
+    TransactionSnapshotBuilder snapshot;
+    bool writeSnapshot = snapshot.open("data/transactionsClean.snap");
+    if (!writeSnapshot) cout << "Error: Cannot create data/transactionsClean.snap\n";
 
     cout << "Cleaning transactions...\n";
-    cleanTransactions(transactions, transSize);
+    size_t transSize = 0;
+    bool cleaned = cleanTransactions("data/transactions.csv", "data/transactionsClean.csv",
+        [&](const TransactionBatch& batch) {
+            if (!writeSnapshot) return;
+            // A full dictionary ends the snapshot but not the clean CSV
+            try {
+                for (size_t i = 0; i < batch.count; i++) {
+                    const CleanTransaction& t = batch.rows[i];
+                    snapshot.append(t.customerID, t.product, t.category, t.price, t.dateKey, t.paymentMethod);
+                }
+            } catch (const overflow_error& e) {
+                cout << "Error: Cannot write data/transactionsClean.snap: " << e.what() << "\n";
+                snapshot.abandon();
+                writeSnapshot = false;
+            }
+        }, transSize);
+
+    if (cleaned && writeSnapshot) {
+        if (snapshot.finish()) cout << "Binary snapshot saved to data/transactionsClean.snap\n";
+        else cout << "Error: Cannot write data/transactionsClean.snap\n";
+    }
     cout << "Loaded " << transSize << " valid transactions.\n";
 
-    delete[] transactions;
     return 0;
 }